@@ -0,0 +1,86 @@
+#include "Adpcm.h"
+#include <algorithm>
+
+namespace {
+
+const int STEP_SIZES[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+const int INDEX_STEPS[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+// Applies one code to the channel state; the encoder runs the same step so
+// it tracks exactly what the decoder will produce.
+inline int step(int code, int& predictor, int& stepIndex) {
+    int size = STEP_SIZES[stepIndex];
+    int delta = size >> 3;
+    if (code & 4) delta += size;
+    if (code & 2) delta += size >> 1;
+    if (code & 1) delta += size >> 2;
+    predictor = std::max(-32768, std::min(32767, (code & 8) ? predictor - delta : predictor + delta));
+    stepIndex = std::max(0, std::min(88, stepIndex + INDEX_STEPS[code]));
+    return predictor;
+}
+
+}
+
+AdpcmSound* encodeAdpcm(const Sint16* samples, Uint32 sampleCount, int channels) {
+    if (channels < 1 || channels > AdpcmSound::MAX_CHANNELS) return nullptr;
+
+    AdpcmSound* sound = new AdpcmSound();
+    sound->channels = channels;
+    sound->samples = sampleCount - sampleCount % channels;
+    sound->data.assign((sound->samples + 1) / 2, 0);
+
+    int predictor[AdpcmSound::MAX_CHANNELS] = {};
+    int stepIndex[AdpcmSound::MAX_CHANNELS] = {};
+    for (Uint32 i = 0; i < sound->samples; i++) {
+        int channel = i % channels;
+        int difference = samples[i] - predictor[channel];
+        int code = 0;
+        if (difference < 0) {
+            code = 8;
+            difference = -difference;
+        }
+        int size = STEP_SIZES[stepIndex[channel]];
+        if (difference >= size) {
+            code |= 4;
+            difference -= size;
+        }
+        if (difference >= size >> 1) {
+            code |= 2;
+            difference -= size >> 1;
+        }
+        if (difference >= size >> 2) {
+            code |= 1;
+        }
+        step(code, predictor[channel], stepIndex[channel]);
+        sound->data[i / 2] |= static_cast<Uint8>(code << ((i & 1) * 4));
+    }
+    return sound;
+}
+
+void AdpcmDecoder::start(const AdpcmSound* source) {
+    sound = source;
+    position = 0;
+    std::fill(predictor, predictor + AdpcmSound::MAX_CHANNELS, 0);
+    std::fill(stepIndex, stepIndex + AdpcmSound::MAX_CHANNELS, 0);
+}
+
+Uint32 AdpcmDecoder::decode(Sint16* out, Uint32 count) {
+    if (!sound) return 0;
+
+    Uint32 channels = static_cast<Uint32>(sound->channels);
+    count = std::min(count - count % channels, sound->samples - position);
+    const Uint8* data = sound->data.data();
+    for (Uint32 i = 0; i < count; i++, position++) {
+        int channel = position % channels;
+        int code = (data[position / 2] >> ((position & 1) * 4)) & 15;
+        out[i] = static_cast<Sint16>(step(code, predictor[channel], stepIndex[channel]));
+    }
+    return count;
+}
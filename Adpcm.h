@@ -0,0 +1,32 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// IMA ADPCM: 4 bits per 16-bit sample, a quarter of the PCM size. Samples
+// stay interleaved in the device's channel layout, one nibble each, low
+// nibble first, so a sound decodes straight into the mix without conversion.
+struct AdpcmSound {
+    static const int MAX_CHANNELS = 8;
+
+    std::vector<Uint8> data;
+    Uint32 samples = 0;
+    int channels = 0;
+};
+
+AdpcmSound* encodeAdpcm(const Sint16* samples, Uint32 sampleCount, int channels);
+
+// Streams a sound out in pieces. Holds the per-channel predictor state, so
+// one decoder serves one playing voice.
+class AdpcmDecoder {
+public:
+    void start(const AdpcmSound* sound);
+    bool finished() const { return !sound || position == sound->samples; }
+    // Decodes up to count samples, ending on a whole frame; returns how many.
+    Uint32 decode(Sint16* out, Uint32 count);
+
+private:
+    const AdpcmSound* sound = nullptr;
+    Uint32 position = 0;
+    int predictor[AdpcmSound::MAX_CHANNELS] = {};
+    int stepIndex[AdpcmSound::MAX_CHANNELS] = {};
+};
@@ -0,0 +1,144 @@
+#include "AssetLoader.h"
+#include "ResourcePack.h"
+#include "StartupTimeline.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const int MAX_WORKERS = 4;
+
+// Claim order. The menu is needed before anything can be shown; the other
+// large PNG decodes follow so they don't end up finishing alone.
+const int JOB_ORDER[] = {
+    IMAGE_MENU, IMAGE_BACKGROUND, IMAGE_PAUSE, IMAGE_WALL, IMAGE_SHURIKEN, IMAGE_PLATFORM,
+    IMAGE_NINJA, IMAGE_ENEMY, IMAGE_HEART,
+    IMAGE_COUNT + SOUND_HIT, IMAGE_COUNT + SOUND_GAME_OVER, IMAGE_COUNT + SOUND_LOSE_LIFE,
+    IMAGE_COUNT + SOUND_JUMP, IMAGE_COUNT + SOUND_ENEMY_SPAWN,
+    IMAGE_COUNT + SOUND_KILL_1, IMAGE_COUNT + SOUND_KILL_2, IMAGE_COUNT + SOUND_KILL_3,
+    IMAGE_COUNT + SOUND_KILL_4, IMAGE_COUNT + SOUND_KILL_5,
+};
+
+}
+
+AssetLoader::AssetLoader(const ResourcePack& pack, Uint32 imageFormat, bool premultipliedAlpha, bool loadSounds)
+    : pack(pack), format(imageFormat), premultiplied(premultipliedAlpha), withSounds(loadSounds),
+      lock(SDL_CreateMutex()), jobDone(SDL_CreateCond()) {
+    static_assert(sizeof(JOB_ORDER) / sizeof(JOB_ORDER[0]) == JOB_COUNT, "every job needs a slot");
+    SDL_AtomicSet(&nextSlot, 0);
+    SDL_AtomicSet(&completedJobs, 0);
+}
+
+AssetLoader::~AssetLoader() {
+    finish();
+    SDL_DestroyCond(jobDone);
+    SDL_DestroyMutex(lock);
+    for (SDL_Surface* surface : images) {
+        SDL_FreeSurface(surface);
+    }
+    for (AdpcmSound* sound : sounds) {
+        delete sound;
+    }
+}
+
+int AssetLoader::defaultWorkerCount() {
+    return std::max(1, std::min(SDL_GetCPUCount() - 1, MAX_WORKERS));
+}
+
+void AssetLoader::start(int workerCount) {
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back({ this, i + 1, nullptr });
+    }
+    // Start threads only once the vector is final so each Worker keeps its address.
+    for (auto& worker : workers) {
+        worker.thread = SDL_CreateThread(workerMain, "AssetLoader", &worker);
+        if (worker.thread) {
+            runningWorkers++;
+        } else {
+            std::cerr << "Failed to start asset worker: " << SDL_GetError() << std::endl;
+        }
+    }
+}
+
+void AssetLoader::wait(ImageId image) {
+    if (runningWorkers == 0) {
+        while (runNextJob(0)) {
+            if (done[image]) return;
+        }
+    }
+
+    SDL_LockMutex(lock);
+    while (!done[image]) {
+        SDL_CondWait(jobDone, lock);
+    }
+    SDL_UnlockMutex(lock);
+}
+
+bool AssetLoader::finished() const {
+    return SDL_AtomicGet(const_cast<SDL_atomic_t*>(&completedJobs)) == JOB_COUNT;
+}
+
+void AssetLoader::finish() {
+    while (runNextJob(0)) {
+    }
+    for (auto& worker : workers) {
+        SDL_WaitThread(worker.thread, nullptr);
+    }
+    workers.clear();
+    runningWorkers = 0;
+}
+
+AdpcmSound* AssetLoader::takeSound(SoundId sound) {
+    AdpcmSound* taken = sounds[sound];
+    sounds[sound] = nullptr;
+    return taken;
+}
+
+void AssetLoader::addToTimeline(StartupTimeline& timeline) const {
+    for (int job = 0; job < JOB_COUNT; job++) {
+        if (timings[job].end == 0) continue;
+        const char* name = job < IMAGE_COUNT ? imageAsset(static_cast<ImageId>(job)).file
+                                             : soundFile(static_cast<SoundId>(job - IMAGE_COUNT));
+        timeline.addSpan(name, timings[job].begin, timings[job].end, timings[job].lane);
+    }
+}
+
+int AssetLoader::workerMain(void* data) {
+    Worker* worker = static_cast<Worker*>(data);
+    while (worker->loader->runNextJob(worker->lane)) {
+    }
+    return 0;
+}
+
+bool AssetLoader::runNextJob(int lane) {
+    int slot = SDL_AtomicAdd(&nextSlot, 1);
+    if (slot >= JOB_COUNT) return false;
+
+    int job = JOB_ORDER[slot];
+    timings[job].lane = lane;
+    timings[job].begin = SDL_GetPerformanceCounter();
+    runJob(job);
+    timings[job].end = SDL_GetPerformanceCounter();
+
+    SDL_LockMutex(lock);
+    done[job] = true;
+    SDL_CondBroadcast(jobDone);
+    SDL_UnlockMutex(lock);
+    SDL_AtomicAdd(&completedJobs, 1);
+    return true;
+}
+
+void AssetLoader::runJob(int job) {
+    if (job < IMAGE_COUNT) {
+        ImageId image = static_cast<ImageId>(job);
+        SDL_Surface* surface = loadCookedImage(pack, image, format, premultiplied);
+        images[image] = surface ? surface : prepareImage(pack, image, format, premultiplied);
+        return;
+    }
+
+    SoundId sound = static_cast<SoundId>(job - IMAGE_COUNT);
+    if (withSounds) {
+        sounds[sound] = loadSound(pack, sound);
+    }
+}
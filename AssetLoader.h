@@ -0,0 +1,71 @@
+#pragma once
+#include <SDL.h>
+#include "Adpcm.h"
+#include <vector>
+#include "Assets.h"
+
+class ResourcePack;
+class StartupTimeline;
+
+// Decodes every image and sound on a pool of worker threads. Only CPU-side
+// work happens here: surfaces come back ready for SDL_CreateTextureFromSurface,
+// which stays on the render thread. The menu image is claimed first so the
+// menu can go up while the rest is still decoding.
+class AssetLoader {
+public:
+    // Sounds are skipped when there is no audio device to decode them for.
+    AssetLoader(const ResourcePack& pack, Uint32 imageFormat, bool premultipliedAlpha, bool loadSounds);
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    ~AssetLoader();
+
+    void start(int workerCount);
+    // Blocks until one image is decoded, running jobs itself if no worker started.
+    void wait(ImageId image);
+    bool finished() const;
+    // Completion fence: the calling thread works through what is left, then
+    // joins the workers.
+    void finish();
+
+    // Owned by the loader until destruction; nullptr if decoding failed.
+    SDL_Surface* image(ImageId image) const { return images[image]; }
+    // Ownership passes to the caller.
+    AdpcmSound* takeSound(SoundId sound);
+
+    void addToTimeline(StartupTimeline& timeline) const;
+    static int defaultWorkerCount();
+
+private:
+    static const int JOB_COUNT = IMAGE_COUNT + SOUND_COUNT;
+
+    struct JobTiming {
+        Uint64 begin = 0;
+        Uint64 end = 0;
+        int lane = 0;
+    };
+
+    struct Worker {
+        AssetLoader* loader;
+        int lane;
+        SDL_Thread* thread;
+    };
+
+    static int workerMain(void* data);
+    bool runNextJob(int lane);
+    void runJob(int job);
+
+    const ResourcePack& pack;
+    Uint32 format;
+    bool premultiplied;
+    bool withSounds;
+    SDL_atomic_t nextSlot;
+    SDL_atomic_t completedJobs;
+    SDL_mutex* lock;
+    SDL_cond* jobDone;
+    bool done[JOB_COUNT] = {};
+    int runningWorkers = 0;
+    std::vector<Worker> workers;
+    SDL_Surface* images[IMAGE_COUNT] = {};
+    AdpcmSound* sounds[SOUND_COUNT] = {};
+    JobTiming timings[JOB_COUNT];
+};
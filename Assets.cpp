@@ -0,0 +1,366 @@
+#include "Assets.h"
+#include "Adpcm.h"
+#include "ImageOps.h"
+#include "ResourcePack.h"
+#include "constants.h"
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+const ImageAsset IMAGE_ASSETS[IMAGE_COUNT] = {
+    { "background.png", SCREEN_WIDTH, SCREEN_HEIGHT },
+    { "wall.png", WALL_WIDTH, SCREEN_HEIGHT },
+    { "ninja.png", PLAYER_WIDTH, PLAYER_HEIGHT },
+    { "shuriken.png", SHURIKEN_WIDTH, SHURIKEN_HEIGHT },
+    { "enemy.png", ENEMY_WIDTH, ENEMY_HEIGHT },
+    { "platform.png", PLATFORM_WIDTH, PLATFORM_HEIGHT },
+    { "heart.gif", HEART_SIZE, HEART_SIZE },
+    { "menu.png", SCREEN_WIDTH, SCREEN_HEIGHT },
+    { "pause.png", SCREEN_WIDTH, SCREEN_HEIGHT },
+};
+
+const char* const SOUND_FILES[SOUND_COUNT] = {
+    "jump.wav", "hit.wav", "lose_life.wav", "game_over.wav",
+    "kill1.wav", "kill2.wav", "kill3.wav", "kill4.wav", "kill5.wav",
+    "spawn.wav",
+};
+
+const char* const MUSIC_FILES[MUSIC_COUNT] = {
+    "music_menu.wav", "music_playing.wav", "music_game_over.wav",
+};
+
+const int SOUND_PRIORITIES[SOUND_COUNT] = {
+    1, 2, 3, 3,
+    2, 2, 2, 2, 2,
+    0,
+};
+
+const char COOKED_MAGIC[4] = { 'N', 'J', 'T', 'X' };
+const Uint8 COOKED_VERSION = 1;
+const size_t COOKED_HEADER_SIZE = 4 + 1 + 1 + 4 * 3;
+
+void putUint32(std::vector<Uint8>& out, Uint32 value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<Uint8>(value >> (i * 8)));
+    }
+}
+
+Uint32 getUint32(const Uint8* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<Uint32>(in[3]) << 24);
+}
+
+bool makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+long fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file ? static_cast<long>(file.tellg()) : 0;
+}
+
+}
+
+const ImageAsset& imageAsset(ImageId image) {
+    return IMAGE_ASSETS[image];
+}
+
+const char* soundFile(SoundId sound) {
+    return SOUND_FILES[sound];
+}
+
+int soundPriority(SoundId sound) {
+    return SOUND_PRIORITIES[sound];
+}
+
+const char* musicFile(MusicId music) {
+    return MUSIC_FILES[music];
+}
+
+std::string cookedImagePath(ImageId image) {
+    std::string name = IMAGE_ASSETS[image].file;
+    return COOKED_DIR + "/" + name.substr(0, name.find('.')) + ".njt";
+}
+
+Uint32 nativeImageFormat(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; i++) {
+            Uint32 format = info.texture_formats[i];
+            if (!SDL_ISPIXELFORMAT_FOURCC(format) && SDL_BITSPERPIXEL(format) == 32 && SDL_ISPIXELFORMAT_ALPHA(format)) {
+                return format;
+            }
+        }
+    }
+    return SDL_PIXELFORMAT_ARGB8888;
+}
+
+SDL_BlendMode premultipliedBlendMode() {
+    return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+}
+
+bool supportsPremultipliedAlpha(SDL_Renderer* renderer) {
+    // The software renderer rejects custom blend modes; probe instead of guessing by name.
+    SDL_Texture* probe = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (!probe) return false;
+    bool supported = SDL_SetTextureBlendMode(probe, premultipliedBlendMode()) == 0;
+    SDL_DestroyTexture(probe);
+    return supported;
+}
+
+SDL_Surface* prepareImage(const ResourcePack& pack, ImageId image, Uint32 format, bool premultiplied) {
+    const ImageAsset& asset = IMAGE_ASSETS[image];
+    SDL_Surface* source = IMG_Load_RW(pack.openAsset(asset.file), 1);
+    if (!source) {
+        std::cerr << "Failed to load image: " << asset.file << " - " << IMG_GetError() << std::endl;
+        return nullptr;
+    }
+
+    SDL_Surface* scaled = resampleSurface(source, asset.width, asset.height);
+    SDL_FreeSurface(source);
+    if (!scaled) {
+        std::cerr << "Failed to scale image: " << asset.file << " - " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    if (premultiplied) {
+        premultiplyAlpha(scaled);
+    }
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(scaled, format, 0);
+    SDL_FreeSurface(scaled);
+    if (!converted) {
+        std::cerr << "Failed to convert image: " << asset.file << " - " << SDL_GetError() << std::endl;
+    }
+    return converted;
+}
+
+AdpcmSound* loadSound(const ResourcePack& pack, SoundId sound) {
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(pack.openAsset(soundFile(sound)), 1);
+    if (!chunk || !Mix_QuerySpec(&frequency, &format, &channels)) {
+        std::cerr << "Failed to load sound: " << soundFile(sound) << " - " << Mix_GetError() << std::endl;
+        Mix_FreeChunk(chunk);
+        return nullptr;
+    }
+
+    AdpcmSound* compressed = nullptr;
+    if (format == AUDIO_S16SYS) {
+        compressed = encodeAdpcm(reinterpret_cast<const Sint16*>(chunk->abuf), chunk->alen / sizeof(Sint16), channels);
+    }
+    if (!compressed) {
+        std::cerr << "Failed to compress sound: " << soundFile(sound) << std::endl;
+    }
+    Mix_FreeChunk(chunk);
+    return compressed;
+}
+
+bool readWavHeader(SDL_RWops* file, WavInfo& info) {
+    Uint8 header[12];
+    if (SDL_RWread(file, header, sizeof(header), 1) != 1 ||
+        std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    Uint8 chunk[8];
+    while (SDL_RWread(file, chunk, sizeof(chunk), 1) == 1) {
+        Uint32 size = getUint32(chunk + 4);
+        if (std::memcmp(chunk, "data", 4) == 0) {
+            info.dataOffset = SDL_RWtell(file);
+            info.dataSize = size;
+            return info.format != 0 && info.channels > 0 && info.rate > 0;
+        }
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            Uint8 format[16];
+            if (SDL_RWread(file, format, sizeof(format), 1) != 1) return false;
+            int tag = format[0] | (format[1] << 8);
+            int bits = format[14] | (format[15] << 8);
+            info.channels = format[2] | (format[3] << 8);
+            info.rate = static_cast<int>(getUint32(format + 4));
+            if (tag == 1 && bits == 8) info.format = AUDIO_U8;
+            else if (tag == 1 && bits == 16) info.format = AUDIO_S16LSB;
+            else if (tag == 1 && bits == 32) info.format = AUDIO_S32LSB;
+            else if (tag == 3 && bits == 32) info.format = AUDIO_F32LSB;
+            size -= sizeof(format);
+        }
+        SDL_RWseek(file, size + (size & 1), RW_SEEK_CUR);
+    }
+    return false;
+}
+
+Uint32 soundLength(const ResourcePack& pack, SoundId sound, int frequency) {
+    SDL_RWops* file = pack.openAsset(soundFile(sound));
+    if (!file) return 0;
+
+    WavInfo info;
+    Uint32 length = 0;
+    if (readWavHeader(file, info)) {
+        Uint64 frames = info.dataSize / (info.channels * (SDL_AUDIO_BITSIZE(info.format) / 8));
+        length = static_cast<Uint32>(frames * frequency / info.rate);
+    }
+    SDL_RWclose(file);
+    return length;
+}
+
+SDL_Surface* loadCookedImage(const ResourcePack& pack, ImageId image, Uint32 format, bool premultiplied) {
+    SDL_RWops* file = pack.openAsset(cookedImagePath(image));
+    if (!file) return nullptr;
+
+    const ImageAsset& asset = IMAGE_ASSETS[image];
+    Uint8 header[COOKED_HEADER_SIZE];
+    int rowBytes = asset.width * SDL_BYTESPERPIXEL(format);
+    bool valid = SDL_RWread(file, header, sizeof(header), 1) == 1 &&
+                 std::equal(COOKED_MAGIC, COOKED_MAGIC + 4, header) && header[4] == COOKED_VERSION &&
+                 (header[5] != 0) == premultiplied &&
+                 static_cast<int>(getUint32(&header[6])) == asset.width &&
+                 static_cast<int>(getUint32(&header[10])) == asset.height &&
+                 getUint32(&header[14]) == format &&
+                 SDL_RWsize(file) == static_cast<Sint64>(COOKED_HEADER_SIZE + static_cast<size_t>(rowBytes) * asset.height);
+
+    SDL_Surface* surface = valid ? SDL_CreateRGBSurfaceWithFormat(0, asset.width, asset.height, SDL_BITSPERPIXEL(format), format) : nullptr;
+    for (int y = 0; surface && y < asset.height; y++) {
+        if (SDL_RWread(file, static_cast<Uint8*>(surface->pixels) + y * surface->pitch, rowBytes, 1) != 1) {
+            SDL_FreeSurface(surface);
+            surface = nullptr;
+        }
+    }
+    SDL_RWclose(file);
+    return surface;
+}
+
+bool saveCookedImage(const std::string& path, SDL_Surface* surface, bool premultiplied) {
+    Uint32 format = surface->format->format;
+    std::vector<Uint8> data(COOKED_MAGIC, COOKED_MAGIC + 4);
+    data.push_back(COOKED_VERSION);
+    data.push_back(premultiplied ? 1 : 0);
+    putUint32(data, surface->w);
+    putUint32(data, surface->h);
+    putUint32(data, format);
+
+    // Rows are stored tightly packed; the loader re-applies its own pitch.
+    int rowBytes = surface->w * SDL_BYTESPERPIXEL(format);
+    for (int y = 0; y < surface->h; y++) {
+        const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+        data.insert(data.end(), row, row + rowBytes);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+int cookAssets() {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG);
+
+    // A hidden window is enough to ask the default renderer what it wants.
+    SDL_Window* window = SDL_CreateWindow("NinJump", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                          SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED) : nullptr;
+    if (!renderer) {
+        std::cerr << "Renderer creation failed: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    Uint32 format = nativeImageFormat(renderer);
+    bool premultiplied = supportsPremultipliedAlpha(renderer);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+
+    int failures = 0;
+    if (!makeDirectory(COOKED_DIR)) {
+        std::cerr << "Failed to create " << COOKED_DIR << std::endl;
+        failures++;
+    }
+
+    std::cout << "Cooking for " << SDL_GetPixelFormatName(format)
+              << (premultiplied ? ", premultiplied alpha" : ", straight alpha") << std::endl;
+    ResourcePack looseFiles;
+    long sourceBytes = 0;
+    long cookedBytes = 0;
+    for (int i = 0; i < IMAGE_COUNT && failures == 0; i++) {
+        ImageId image = static_cast<ImageId>(i);
+        std::string path = cookedImagePath(image);
+        SDL_Surface* surface = prepareImage(looseFiles, image, format, premultiplied);
+        if (!surface || !saveCookedImage(path, surface, premultiplied)) {
+            std::cerr << "Failed to cook " << IMAGE_ASSETS[i].file << std::endl;
+            failures++;
+        } else {
+            long before = fileSize(IMAGE_ASSETS[i].file);
+            long after = fileSize(path);
+            std::cout << IMAGE_ASSETS[i].file << " -> " << path << " (" << surface->w << "x" << surface->h << ", "
+                      << before << " -> " << after << " bytes)" << std::endl;
+            sourceBytes += before;
+            cookedBytes += after;
+        }
+        SDL_FreeSurface(surface);
+    }
+    std::cout << "Total " << sourceBytes << " -> " << cookedBytes << " bytes" << std::endl;
+
+    IMG_Quit();
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
+
+int packAssets() {
+    std::vector<std::string> files = { FONT_FILE };
+    for (int i = 0; i < IMAGE_COUNT; i++) {
+        files.push_back(IMAGE_ASSETS[i].file);
+        // Cooked images ride along when present so a packed install skips decoding too.
+        std::string cooked = cookedImagePath(static_cast<ImageId>(i));
+        if (std::ifstream(cooked, std::ios::binary)) {
+            files.push_back(cooked);
+        }
+    }
+    for (const char* file : SOUND_FILES) {
+        files.push_back(file);
+    }
+    for (const char* file : MUSIC_FILES) {
+        if (std::ifstream(file, std::ios::binary)) {
+            files.push_back(file);
+        }
+    }
+
+    if (!ResourcePack::write(PACK_FILE, files)) {
+        std::cerr << "Failed to write " << PACK_FILE << std::endl;
+        return 1;
+    }
+
+    ResourcePack pack;
+    if (!pack.open(PACK_FILE) || !pack.verify()) {
+        std::cerr << "Failed to verify " << PACK_FILE << std::endl;
+        return 1;
+    }
+
+    long looseBytes = 0;
+    for (const auto& file : files) {
+        looseBytes += fileSize(file);
+    }
+    std::cout << "Packed " << files.size() << " files (" << looseBytes << " bytes) into " << PACK_FILE
+              << " (" << fileSize(PACK_FILE) << " bytes)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+
+class ResourcePack;
+struct AdpcmSound;
+
+enum ImageId {
+    IMAGE_BACKGROUND,
+    IMAGE_WALL,
+    IMAGE_NINJA,
+    IMAGE_SHURIKEN,
+    IMAGE_ENEMY,
+    IMAGE_PLATFORM,
+    IMAGE_HEART,
+    IMAGE_MENU,
+    IMAGE_PAUSE,
+    IMAGE_COUNT
+};
+
+enum SoundId {
+    SOUND_JUMP,
+    SOUND_HIT,
+    SOUND_LOSE_LIFE,
+    SOUND_GAME_OVER,
+    SOUND_KILL_1,
+    SOUND_KILL_2,
+    SOUND_KILL_3,
+    SOUND_KILL_4,
+    SOUND_KILL_5,
+    SOUND_ENEMY_SPAWN,
+    SOUND_COUNT
+};
+
+enum MusicId {
+    MUSIC_MENU,
+    MUSIC_PLAYING,
+    MUSIC_GAME_OVER,
+    MUSIC_COUNT
+};
+
+// Layout and position of the samples in a PCM or float WAV file.
+struct WavInfo {
+    SDL_AudioFormat format = 0;
+    int channels = 0;
+    int rate = 0;
+    Sint64 dataOffset = 0;
+    Uint32 dataSize = 0;
+};
+
+// Source file and the size the image is drawn at.
+struct ImageAsset {
+    const char* file;
+    int width;
+    int height;
+};
+
+const ImageAsset& imageAsset(ImageId image);
+std::string cookedImagePath(ImageId image);
+const char* soundFile(SoundId sound);
+// Higher-priority sounds may take over the voice of lower ones when all are busy.
+int soundPriority(SoundId sound);
+// Looping track for one game state; optional, a missing file plays silence.
+const char* musicFile(MusicId music);
+
+// First 32-bit alpha format the renderer accepts natively, so texture upload is a copy.
+Uint32 nativeImageFormat(SDL_Renderer* renderer);
+SDL_BlendMode premultipliedBlendMode();
+bool supportsPremultipliedAlpha(SDL_Renderer* renderer);
+
+// Decodes the source file and resamples it to its draw size in the given
+// format. This is exactly what the cook step writes out.
+SDL_Surface* prepareImage(const ResourcePack& pack, ImageId image, Uint32 format, bool premultiplied);
+
+// Returns nullptr when the cooked file is missing or was cooked for a
+// different size, format or alpha mode; callers fall back to prepareImage.
+SDL_Surface* loadCookedImage(const ResourcePack& pack, ImageId image, Uint32 format, bool premultiplied);
+bool saveCookedImage(const std::string& path, SDL_Surface* surface, bool premultiplied);
+
+// Decodes the WAV into the open audio device's format and keeps it ADPCM-compressed.
+AdpcmSound* loadSound(const ResourcePack& pack, SoundId sound);
+// Reads chunks up to the sample data and leaves the file positioned at its start.
+bool readWavHeader(SDL_RWops* file, WavInfo& info);
+// Length in frames at the given rate, read from the WAV header alone; 0 if unreadable.
+Uint32 soundLength(const ResourcePack& pack, SoundId sound, int frequency);
+
+// Offline tools: cook every image into COOKED_DIR for the default renderer,
+// and bundle the font, sounds, images and any cooked images into PACK_FILE.
+int cookAssets();
+int packAssets();
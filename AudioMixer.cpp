@@ -0,0 +1,243 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+AudioMixer::~AudioMixer() {
+    close();
+}
+
+bool AudioMixer::open(int bufferFrames, MusicStream* stream) {
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+        std::cerr << "Audio mixer needs an open device: " << Mix_GetError() << std::endl;
+        return false;
+    }
+    if (format != AUDIO_S16SYS) {
+        std::cerr << "Audio mixer only mixes 16-bit samples, device format is " << format << std::endl;
+        return false;
+    }
+
+    music = stream;
+    bufferMs = 1000.0 * bufferFrames / frequency;
+    bufferCounts = static_cast<Uint64>(SDL_GetPerformanceFrequency() * (static_cast<double>(bufferFrames) / frequency));
+    windowCounts = SDL_GetPerformanceFrequency() * AUDIO_UNDERRUN_WINDOW_MS / 1000;
+    lastCallback = 0;
+    deadline = 0;
+    windowUnderruns = 0;
+    SDL_AtomicSet(&underrunCount, 0);
+    SDL_AtomicSet(&underrunTotal, 0);
+    SDL_AtomicSet(&underrunGapUs, 0);
+    for (auto& histogram : latencyHistogram) {
+        for (SDL_atomic_t& bucket : histogram) {
+            SDL_AtomicSet(&bucket, 0);
+        }
+    }
+
+    Mix_HookMusic(mixCallback, this);
+    hooked = true;
+    return true;
+}
+
+void AudioMixer::openNull(const Uint32 soundFrames[SOUND_COUNT], bool recordEvents) {
+    close();
+    std::copy(soundFrames, soundFrames + SOUND_COUNT, nullLengths);
+    nullFrame = 0;
+    recording = recordEvents;
+    eventLog.clear();
+    nullOutput = true;
+}
+
+void AudioMixer::close() {
+    if (!isOpen()) return;
+    if (hooked) {
+        // Takes the device lock, so the callback is not running once this returns.
+        Mix_HookMusic(nullptr, nullptr);
+    }
+    hooked = false;
+    nullOutput = false;
+    for (Voice& voice : voices) {
+        voice = Voice();
+    }
+    Command command;
+    while (commands.pop(command)) {}
+    pending = 0;
+    pendingCount = 0;
+    SDL_AtomicSet(&underrunCount, 0);
+}
+
+void AudioMixer::setSound(SoundId sound, const AdpcmSound* data) {
+    sounds[sound] = data;
+}
+
+void AudioMixer::play(SoundId sound) {
+    // A merged trigger is measured from the first one.
+    if (pending & (1u << sound)) return;
+    if (!nullOutput) {
+        triggered[sound] = SDL_GetPerformanceCounter();
+    }
+    pending |= 1u << sound;
+    pendingOrder[pendingCount++] = sound;
+}
+
+void AudioMixer::endTick(Uint64 tick) {
+    if (nullOutput) {
+        for (int i = 0; i < pendingCount; i++) {
+            Command command = { pendingOrder[i], nullptr, 0 };
+            int channel = startVoice(command);
+            if (recording) {
+                eventLog.push_back({ tick, nullFrame, command.sound, channel });
+            }
+        }
+        pending = 0;
+        pendingCount = 0;
+        nullFrame += AUDIO_FREQUENCY / SIM_TICK_RATE;
+        return;
+    }
+    if (!pending) return;
+
+    for (int i = 0; i < pendingCount; i++) {
+        SoundId sound = pendingOrder[i];
+        if (!sounds[sound] || !hooked) continue;
+
+        Command command = { static_cast<SoundId>(sound), sounds[sound], triggered[sound] };
+        // A full queue means the device has stalled; dropping is better than blocking.
+        commands.push(command);
+    }
+    pending = 0;
+    pendingCount = 0;
+}
+
+void SDLCALL AudioMixer::mixCallback(void* data, Uint8* stream, int length) {
+    static_cast<AudioMixer*>(data)->mix(reinterpret_cast<Sint16*>(stream), length / static_cast<int>(sizeof(Sint16)));
+}
+
+void AudioMixer::mix(Sint16* out, int sampleCount) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (windowUnderruns && now - windowStart > windowCounts) {
+        windowUnderruns = 0;
+        SDL_AtomicSet(&underrunCount, 0);
+    }
+    // Every callback hands the device one more buffer, so the device runs dry
+    // at the deadline unless called again. Backends that call back in bursts
+    // push it several buffers ahead, so only a callback more than a whole
+    // buffer past it counts as an underrun rather than jitter.
+    if (deadline && now > deadline + bufferCounts) {
+        if (!windowUnderruns) {
+            windowStart = now;
+        }
+        SDL_AtomicSet(&underrunGapUs, static_cast<int>((now - lastCallback) * 1000000 / SDL_GetPerformanceFrequency()));
+        SDL_AtomicSet(&underrunCount, ++windowUnderruns);
+        SDL_AtomicAdd(&underrunTotal, 1);
+        deadline = now;
+    }
+    // The device can't hold more than a few buffers however fast they arrive.
+    deadline = std::min(std::max(deadline, now) + bufferCounts, now + 4 * bufferCounts);
+    lastCallback = now;
+
+    const double countsPerBucket = SDL_GetPerformanceFrequency() / (1000.0 * LATENCY_BUCKETS_PER_MS);
+    Command command;
+    while (commands.pop(command)) {
+        int bucket = static_cast<int>((now - command.triggered) / countsPerBucket);
+        SDL_AtomicAdd(&latencyHistogram[command.sound][std::min(bucket, LATENCY_BUCKETS - 1)], 1);
+        startVoice(command);
+    }
+
+    for (int offset = 0; offset < sampleCount; offset += MIX_BLOCK) {
+        int count = sampleCount - offset < MIX_BLOCK ? sampleCount - offset : MIX_BLOCK;
+        Sint16* block = out + offset;
+        for (int i = 0; i < count; i++) {
+            accumulator[i] = block[i];
+        }
+        if (music) {
+            music->mix(accumulator, count);
+        }
+
+        for (Voice& voice : voices) {
+            if (!busy(voice)) continue;
+
+            Uint32 mixed = voice.decoder.decode(decoded, static_cast<Uint32>(count));
+            for (Uint32 i = 0; i < mixed; i++) {
+                accumulator[i] += decoded[i];
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            block[i] = static_cast<Sint16>(std::max(-32768, std::min(32767, accumulator[i])));
+        }
+    }
+}
+
+bool AudioMixer::busy(const Voice& voice) const {
+    return nullOutput ? voice.endFrame > nullFrame : !voice.decoder.finished();
+}
+
+int AudioMixer::startVoice(const Command& command) {
+    int priority = soundPriority(command.sound);
+
+    Voice* target = nullptr;
+    for (Voice& voice : voices) {
+        if (!busy(voice)) {
+            target = &voice;
+            break;
+        }
+        if (voice.priority > priority) continue;
+        if (!target || voice.priority < target->priority ||
+            (voice.priority == target->priority && voice.started < target->started)) {
+            target = &voice;
+        }
+    }
+    // Everything playing outranks the new sound.
+    if (!target) return -1;
+
+    if (nullOutput) {
+        target->endFrame = nullFrame + nullLengths[command.sound];
+    } else {
+        target->decoder.start(command.data);
+    }
+    target->priority = priority;
+    target->started = ++voiceStarts;
+    return static_cast<int>(target - voices);
+}
+
+AudioLatency AudioMixer::latency(SoundId sound) const {
+    AudioLatency result;
+    result.bufferMs = bufferMs;
+
+    Uint32 counts[LATENCY_BUCKETS];
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        counts[i] = static_cast<Uint32>(SDL_AtomicGet(&latencyHistogram[sound][i]));
+        result.count += counts[i];
+    }
+    if (!result.count) return result;
+
+    // Percentiles are reported at the upper edge of their bucket.
+    Uint32 seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        Uint32 before = seen;
+        seen += counts[i];
+        double edgeMs = static_cast<double>(i + 1) / LATENCY_BUCKETS_PER_MS;
+        if (before * 2 < result.count && seen * 2 >= result.count) result.p50Ms = edgeMs;
+        if (before * 100 < result.count * 99 && seen * 100 >= result.count * 99) result.p99Ms = edgeMs;
+    }
+    return result;
+}
+
+void AudioMixer::reportLatency(std::ostream& out, SoundId sound) const {
+    AudioLatency stats = latency(sound);
+    if (!stats.count) return;
+
+    out << std::fixed << std::setprecision(2) << soundFile(sound) << ": " << stats.count
+        << " triggers, trigger to callback p50 " << stats.p50Ms << " ms, p99 " << stats.p99Ms
+        << " ms, plus " << stats.bufferMs << " ms buffer, " << totalUnderruns() << " underruns" << std::endl;
+    out.unsetf(std::ios::fixed);
+}
+
+void AudioMixer::writeEvents(std::ostream& out) const {
+    out << "tick\tframe\tsound\tchannel\n";
+    for (const AudioEvent& event : eventLog) {
+        out << event.tick << '\t' << event.frame << '\t' << soundFile(event.sound) << '\t' << event.channel << '\n';
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include "Adpcm.h"
+#include "Assets.h"
+#include "MusicStream.h"
+#include "SpscQueue.h"
+#include "constants.h"
+#include <ostream>
+#include <vector>
+
+// Trigger-to-callback latency for one sound, summarised from its histogram.
+struct AudioLatency {
+    Uint32 count = 0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    // Time for one buffer to drain: what the device adds after the callback.
+    double bufferMs = 0.0;
+};
+
+// One sound trigger as recorded by the null output.
+struct AudioEvent {
+    Uint64 tick;
+    // Output frame the sound starts on.
+    Uint64 frame;
+    SoundId sound;
+    // Voice the sound went to, or -1 when every busy voice outranked it.
+    int channel;
+};
+
+// Mixes sound effects from a fixed voice pool inside the audio callback of
+// the device SDL_mixer opened, on top of the music a MusicStream passed to
+// open() supplies. Sounds stay ADPCM-compressed in memory; each voice decodes
+// its sound a block at a time as it plays. The game thread never takes the
+// device lock: play() only marks a sound, and endTick() pushes one command
+// per marked sound through a lock-free queue, in the order the sounds were
+// first played, so a sound triggered several times in one tick starts once.
+// When every voice is busy the new sound takes over the lowest-priority,
+// oldest voice, provided it ranks at least as high.
+//
+// Every trigger is timestamped in play() and again when the callback picks it
+// up. A callback arriving more than a buffer after the device would have run
+// dry counts as an underrun; several within AUDIO_UNDERRUN_WINDOW_MS mean the
+// buffer is too small and should be grown.
+//
+// Without a device, openNull() keeps the same interface but plays nothing:
+// the voice pool is stepped on the game thread in tick time, using each
+// sound's length, and when asked to, every trigger is logged with the voice
+// it got.
+class AudioMixer {
+public:
+    AudioMixer() = default;
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+    ~AudioMixer();
+
+    // Call after Mix_OpenAudio with the same buffer size. Music, if given, is
+    // mixed under the effects and must outlive close().
+    bool open(int bufferFrames, MusicStream* music = nullptr);
+    // soundFrames holds each sound's length in output frames.
+    void openNull(const Uint32 soundFrames[SOUND_COUNT], bool recordEvents);
+    // Unhooks from the device; no voice touches sample data after it returns.
+    void close();
+    bool isOpen() const { return hooked || nullOutput; }
+    bool isNull() const { return nullOutput; }
+
+    // Game thread only. The sound must stay alive until close().
+    void setSound(SoundId sound, const AdpcmSound* data);
+    void play(SoundId sound);
+    // tick only labels null-output events.
+    void endTick(Uint64 tick);
+
+    // Null output opened with recordEvents only.
+    void writeEvents(std::ostream& out) const;
+
+    // Safe to call from the game thread at any time. underruns() counts those
+    // within the current AUDIO_UNDERRUN_WINDOW_MS and drops to 0 once it passes.
+    int underruns() const { return SDL_AtomicGet(&underrunCount); }
+    int totalUnderruns() const { return SDL_AtomicGet(&underrunTotal); }
+    // Time between the late callback and the one before it, for the last underrun.
+    double lastUnderrunGapMs() const { return SDL_AtomicGet(&underrunGapUs) / 1000.0; }
+    AudioLatency latency(SoundId sound) const;
+    void reportLatency(std::ostream& out, SoundId sound) const;
+
+private:
+    static const int MIX_BLOCK = 1024;
+    // Trigger-to-callback histogram: quarter-millisecond buckets, the last one open-ended.
+    static const int LATENCY_BUCKETS = 256;
+    static const int LATENCY_BUCKETS_PER_MS = 4;
+
+    struct Command {
+        SoundId sound;
+        const AdpcmSound* data;
+        Uint64 triggered;
+    };
+
+    struct Voice {
+        AdpcmDecoder decoder;
+        int priority = 0;
+        Uint64 started = 0;
+        // Null output: the frame the sound would finish on.
+        Uint64 endFrame = 0;
+    };
+
+    static void SDLCALL mixCallback(void* data, Uint8* stream, int length);
+    void mix(Sint16* out, int sampleCount);
+    bool busy(const Voice& voice) const;
+    int startVoice(const Command& command);
+
+    const AdpcmSound* sounds[SOUND_COUNT] = {};
+    Uint32 pending = 0;
+    // Marked sounds in the order they were first played this tick.
+    SoundId pendingOrder[SOUND_COUNT] = {};
+    int pendingCount = 0;
+    Uint64 triggered[SOUND_COUNT] = {};
+    bool hooked = false;
+    MusicStream* music = nullptr;
+    bool nullOutput = false;
+    Uint32 nullLengths[SOUND_COUNT] = {};
+    Uint64 nullFrame = 0;
+    bool recording = false;
+    std::vector<AudioEvent> eventLog;
+    Uint64 bufferCounts = 0;
+    Uint64 windowCounts = 0;
+    double bufferMs = 0.0;
+    // Mutable because SDL_AtomicGet takes a non-const pointer.
+    mutable SDL_atomic_t underrunCount = {};
+    mutable SDL_atomic_t underrunTotal = {};
+    mutable SDL_atomic_t underrunGapUs = {};
+    mutable SDL_atomic_t latencyHistogram[SOUND_COUNT][LATENCY_BUCKETS] = {};
+    SpscQueue<Command, 64> commands;
+
+    // Audio thread only, or the game thread with null output.
+    Voice voices[AUDIO_VOICES];
+    Uint64 voiceStarts = 0;
+    Uint64 lastCallback = 0;
+    // When the device runs dry if no further callback comes.
+    Uint64 deadline = 0;
+    Uint64 windowStart = 0;
+    int windowUnderruns = 0;
+    Sint32 accumulator[MIX_BLOCK];
+    Sint16 decoded[MIX_BLOCK];
+};
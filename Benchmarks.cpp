@@ -0,0 +1,177 @@
+#include "Benchmarks.h"
+#include "AudioMixer.h"
+#include "Collision.h"
+#include "Game.h"
+#include "Random.h"
+#include "ResourcePack.h"
+#include "constants.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+double elapsedNs(Uint64 startCounter) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - startCounter) * 1e9 / SDL_GetPerformanceFrequency();
+}
+
+}
+
+// Compares the per-pair checkCollision loop with the batch intersectRects
+// kernel over random rectangles the size of our sprites.
+int runCollisionBenchmark() {
+    const size_t sizes[] = { 10, 100, 1000, 10000 };
+    const size_t TESTS_PER_SIZE = 50000000;
+    const size_t QUERY_COUNT = 256;
+
+    Random random(12345, 0);
+    std::vector<SDL_Rect> queries(QUERY_COUNT);
+    for (auto& query : queries) {
+        query = { static_cast<int>(random.below(SCREEN_WIDTH)), static_cast<int>(random.below(SCREEN_HEIGHT)),
+                  PLAYER_WIDTH, PLAYER_HEIGHT };
+    }
+
+    std::cout << "intersectRects backend: " << intersectRectsBackend() << std::endl;
+    std::cout << std::setw(8) << "rects" << std::setw(16) << "scalar ns/rect"
+              << std::setw(16) << "batch ns/rect" << std::setw(10) << "speedup" << std::endl;
+
+    bool mismatch = false;
+    for (size_t count : sizes) {
+        std::vector<int> x(count), y(count), w(count), h(count);
+        for (size_t i = 0; i < count; i++) {
+            x[i] = static_cast<int>(random.below(SCREEN_WIDTH));
+            y[i] = static_cast<int>(random.below(SCREEN_HEIGHT));
+            w[i] = 14 + static_cast<int>(random.below(17));
+            h[i] = 14 + static_cast<int>(random.below(31));
+        }
+        std::vector<Uint64> hits((count + 63) / 64);
+        size_t rounds = TESTS_PER_SIZE / count;
+
+        size_t scalarHits = 0;
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        for (size_t r = 0; r < rounds; r++) {
+            const SDL_Rect& area = queries[r % QUERY_COUNT];
+            for (size_t i = 0; i < count; i++) {
+                SDL_Rect rect = { x[i], y[i], w[i], h[i] };
+                scalarHits += checkCollision(area, rect);
+            }
+        }
+        double scalarNs = elapsedNs(startCounter);
+
+        size_t batchHits = 0;
+        startCounter = SDL_GetPerformanceCounter();
+        for (size_t r = 0; r < rounds; r++) {
+            batchHits += intersectRects(queries[r % QUERY_COUNT], x.data(), y.data(), w.data(), h.data(), count, hits.data());
+        }
+        double batchNs = elapsedNs(startCounter);
+
+        if (scalarHits != batchHits) {
+            std::cerr << "Hit count mismatch at " << count << " rects: " << scalarHits << " vs " << batchHits << std::endl;
+            mismatch = true;
+        }
+
+        double tests = static_cast<double>(rounds) * count;
+        std::cout << std::setw(8) << count << std::fixed << std::setprecision(3)
+                  << std::setw(16) << scalarNs / tests << std::setw(16) << batchNs / tests
+                  << std::setw(9) << std::setprecision(2) << scalarNs / batchNs << "x" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return mismatch ? 1 : 0;
+}
+
+// Renders the same recorded frames through SDL's software renderer and
+// through SoftwareRasterizer, both into a hidden window.
+int runRenderBenchmark(const char* replayPath) {
+    const Uint32 MAX_FRAMES = 3600;
+
+    Replay replay;
+    if (!replay.load(replayPath)) {
+        std::cerr << "Failed to load replay: " << replayPath << std::endl;
+        return 1;
+    }
+
+    const RenderBackend backends[] = { RenderBackend::SOFTWARE, RenderBackend::CPU_RASTER };
+    const char* names[] = { "SDL_RENDERER_SOFTWARE", "SoftwareRasterizer" };
+    double frameMs[2] = {};
+    for (int i = 0; i < 2; i++) {
+        Game game;
+        game.setRenderBackend(backends[i], true);
+        if (!game.init()) return 1;
+        frameMs[i] = game.benchmarkReplay(replay, MAX_FRAMES);
+        if (frameMs[i] < 0.0) return 1;
+    }
+
+    std::cout << "blend kernel: " << SoftwareRasterizer::blendBackend() << ", "
+              << SoftwareRasterizer::defaultThreadCount() << " threads, "
+              << std::min(replay.tickCount, MAX_FRAMES) << " frames" << std::endl;
+    for (int i = 0; i < 2; i++) {
+        std::cout << std::setw(24) << names[i] << std::fixed << std::setprecision(3)
+                  << std::setw(10) << frameMs[i] << " ms/frame" << std::endl;
+    }
+    std::cout << std::setw(24) << "speedup" << std::setw(10) << std::setprecision(2)
+              << frameMs[0] / frameMs[1] << "x" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    return 0;
+}
+
+// Triggers the jump sound through AudioMixer at the game's tick rate for each
+// buffer size and reports how long triggers wait for the audio callback. The
+// buffer itself adds another bufferMs before the sound leaves the device.
+int runAudioLatencyBenchmark() {
+    const int bufferSizes[] = { 256, 512, 1024, 2048 };
+    const int TRIGGERS = 60;
+    const int TICKS_BETWEEN_TRIGGERS = 5;
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    ResourcePack pack;
+    pack.open(PACK_FILE);
+
+    std::cout << std::setw(8) << "frames" << std::setw(12) << "buffer ms" << std::setw(10) << "p50 ms"
+              << std::setw(10) << "p99 ms" << std::setw(12) << "est. total" << std::setw(11) << "underruns" << std::endl;
+
+    int result = 0;
+    for (int frames : bufferSizes) {
+        if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, frames) < 0) {
+            std::cerr << "SDL_mixer initialization failed: " << Mix_GetError() << std::endl;
+            result = 1;
+            break;
+        }
+
+        AdpcmSound* jump = loadSound(pack, SOUND_JUMP);
+        AudioMixer mixer;
+        if (!jump || !mixer.open(frames)) {
+            delete jump;
+            Mix_CloseAudio();
+            result = 1;
+            break;
+        }
+        mixer.setSound(SOUND_JUMP, jump);
+
+        for (int tick = 0; tick < TRIGGERS * TICKS_BETWEEN_TRIGGERS; tick++) {
+            if (tick % TICKS_BETWEEN_TRIGGERS == 0) {
+                mixer.play(SOUND_JUMP);
+            }
+            mixer.endTick(tick);
+            SDL_Delay(1000 / SIM_TICK_RATE);
+        }
+
+        AudioLatency stats = mixer.latency(SOUND_JUMP);
+        int underruns = mixer.totalUnderruns();
+        mixer.close();
+        delete jump;
+        Mix_CloseAudio();
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(8) << frames << std::setw(12) << stats.bufferMs
+                  << std::setw(10) << stats.p50Ms << std::setw(10) << stats.p99Ms
+                  << std::setw(12) << stats.p50Ms + stats.bufferMs << std::setw(11) << underruns << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    SDL_Quit();
+    return result;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+int runCollisionBenchmark();
+int runRenderBenchmark(const char* replayPath);
+int runAudioLatencyBenchmark();
@@ -0,0 +1,76 @@
+#include "Broadphase.h"
+#include <climits>
+
+LaneBroadphase::LaneBroadphase(size_t capacity) : hitWords(capacity / 64 + 1) {
+    for (auto& bucket : lanes) {
+        bucket.staging.reserve(capacity);
+        bucket.x.reserve(capacity);
+        bucket.y.reserve(capacity);
+        bucket.w.reserve(capacity);
+        bucket.h.reserve(capacity);
+        bucket.ids.reserve(capacity);
+    }
+    clear();
+}
+
+void LaneBroadphase::clear() {
+    for (auto& bucket : lanes) {
+        bucket.staging.clear();
+        bucket.x.clear();
+        bucket.y.clear();
+        bucket.w.clear();
+        bucket.h.clear();
+        bucket.ids.clear();
+        bucket.minLeft = INT_MAX;
+        bucket.maxRight = INT_MIN;
+        bucket.maxHeight = 0;
+    }
+}
+
+void LaneBroadphase::insert(const SDL_Rect& rect, Lane lane, Uint32 id) {
+    LaneBucket& bucket = lanes[lane];
+    Entry entry = { rect.y, rect.x, rect.w, rect.h, id };
+    bucket.staging.push_back(entry);
+    if (rect.x < bucket.minLeft) bucket.minLeft = rect.x;
+    if (rect.x + rect.w > bucket.maxRight) bucket.maxRight = rect.x + rect.w;
+    if (rect.h > bucket.maxHeight) bucket.maxHeight = rect.h;
+}
+
+// Insertion sort: everything in a lane scrolls at the same speed, so the
+// input is already in order or nearly so and this stays linear.
+void LaneBroadphase::build() {
+    for (auto& bucket : lanes) {
+        std::vector<Entry>& entries = bucket.staging;
+        for (size_t i = 1; i < entries.size(); i++) {
+            Entry entry = entries[i];
+            size_t j = i;
+            while (j > 0 && entries[j - 1].y > entry.y) {
+                entries[j] = entries[j - 1];
+                j--;
+            }
+            entries[j] = entry;
+        }
+
+        for (const auto& entry : entries) {
+            bucket.x.push_back(entry.x);
+            bucket.y.push_back(entry.y);
+            bucket.w.push_back(entry.w);
+            bucket.h.push_back(entry.h);
+            bucket.ids.push_back(entry.id);
+        }
+    }
+}
+
+size_t LaneBroadphase::lowerBound(const LaneBucket& bucket, int y) {
+    size_t low = 0;
+    size_t high = bucket.y.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (bucket.y[mid] < y) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "EntityStore.h"
+#include "Collision.h"
+
+// Collision broadphase that exploits every entity sitting in one of the two
+// wall lanes. Entries are bucketed by lane and kept sorted by y, so a query
+// only visits the lanes its x-range reaches and, within them, the entries
+// whose y-range can overlap it.
+class LaneBroadphase {
+public:
+    explicit LaneBroadphase(size_t capacity);
+
+    void clear();
+    void insert(const SDL_Rect& rect, Lane lane, Uint32 id);
+    void build();
+
+    // Calls visit(id) for each entry overlapping area; stops early if visit returns true.
+    template <typename Visitor>
+    void query(const SDL_Rect& area, Visitor visit) const {
+        for (int l = 0; l < LANE_COUNT; l++) {
+            const LaneBucket& bucket = lanes[l];
+            if (bucket.y.empty() || area.x >= bucket.maxRight || area.x + area.w <= bucket.minLeft) {
+                continue;
+            }
+
+            size_t begin = lowerBound(bucket, area.y - bucket.maxHeight + 1);
+            size_t end = lowerBound(bucket, area.y + area.h);
+            if (begin >= end) continue;
+
+            size_t count = end - begin;
+            intersectRects(area, &bucket.x[begin], &bucket.y[begin], &bucket.w[begin], &bucket.h[begin], count, hitWords.data());
+            for (size_t word = 0; word < (count + 63) / 64; word++) {
+                Uint64 bits = hitWords[word];
+                while (bits) {
+                    size_t i = word * 64 + lowestSetBit(bits);
+                    bits &= bits - 1;
+                    if (visit(bucket.ids[begin + i])) return;
+                }
+            }
+        }
+    }
+
+private:
+    static const int LANE_COUNT = 2;
+
+    struct Entry {
+        int y;
+        int x;
+        int w;
+        int h;
+        Uint32 id;
+    };
+
+    // Entries are sorted in staging and then packed into parallel arrays for
+    // the batch intersection kernel.
+    struct LaneBucket {
+        std::vector<Entry> staging;
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<int> w;
+        std::vector<int> h;
+        std::vector<Uint32> ids;
+        int minLeft;
+        int maxRight;
+        int maxHeight;
+    };
+
+    static size_t lowerBound(const LaneBucket& bucket, int y);
+
+    LaneBucket lanes[LANE_COUNT];
+    mutable std::vector<Uint64> hitWords;
+};
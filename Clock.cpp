@@ -0,0 +1,17 @@
+#include "Clock.h"
+#include "constants.h"
+
+VirtualClock::VirtualClock(Uint64 startTick) : ticks(startTick) {
+}
+
+Uint32 VirtualClock::now() const {
+    return static_cast<Uint32>(ticks * 1000 / SIM_TICK_RATE);
+}
+
+void VirtualClock::advance() {
+    ticks++;
+}
+
+Uint64 VirtualClock::tick() const {
+    return ticks;
+}
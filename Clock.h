@@ -0,0 +1,15 @@
+#pragma once
+#include <SDL.h>
+
+// Simulation time derived from the tick count, so a run advances identically
+// whether it is paced in real time or stepped as fast as possible.
+class VirtualClock {
+public:
+    explicit VirtualClock(Uint64 startTick = 0);
+    Uint32 now() const;
+    void advance();
+    Uint64 tick() const;
+
+private:
+    Uint64 ticks;
+};
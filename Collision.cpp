@@ -0,0 +1,132 @@
+#include "Collision.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NINJUMP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if NINJUMP_SSE2 && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NINJUMP_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+typedef size_t (*IntersectFn)(const SDL_Rect&, const int*, const int*, const int*, const int*, size_t, Uint64*);
+
+size_t scalarTail(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                  size_t begin, size_t count, Uint64* hits) {
+    size_t found = 0;
+    for (size_t i = begin; i < count; i++) {
+        bool hit = area.x < x[i] + w[i] && area.x + area.w > x[i] && area.y < y[i] + h[i] && area.y + area.h > y[i];
+        hits[i / 64] |= static_cast<Uint64>(hit) << (i % 64);
+        found += hit;
+    }
+    return found;
+}
+
+void clearHits(Uint64* hits, size_t count) {
+    for (size_t i = 0; i < (count + 63) / 64; i++) {
+        hits[i] = 0;
+    }
+}
+
+#if NINJUMP_SSE2
+size_t intersectRectsSse2(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                          size_t count, Uint64* hits) {
+    clearHits(hits, count);
+
+    const __m128i left = _mm_set1_epi32(area.x);
+    const __m128i right = _mm_set1_epi32(area.x + area.w);
+    const __m128i top = _mm_set1_epi32(area.y);
+    const __m128i bottom = _mm_set1_epi32(area.y + area.h);
+
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i bx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        __m128i by = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+        __m128i bw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+        __m128i bh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+
+        __m128i overlap = _mm_and_si128(
+            _mm_and_si128(_mm_cmpgt_epi32(_mm_add_epi32(bx, bw), left), _mm_cmpgt_epi32(right, bx)),
+            _mm_and_si128(_mm_cmpgt_epi32(_mm_add_epi32(by, bh), top), _mm_cmpgt_epi32(bottom, by)));
+
+        Uint64 bits = static_cast<Uint64>(_mm_movemask_ps(_mm_castsi128_ps(overlap)));
+        hits[i / 64] |= bits << (i % 64);
+        found += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + (bits >> 3);
+    }
+
+    return found + scalarTail(area, x, y, w, h, i, count, hits);
+}
+#endif
+
+#if NINJUMP_AVX2
+__attribute__((target("avx2")))
+size_t intersectRectsAvx2(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                          size_t count, Uint64* hits) {
+    clearHits(hits, count);
+
+    const __m256i left = _mm256_set1_epi32(area.x);
+    const __m256i right = _mm256_set1_epi32(area.x + area.w);
+    const __m256i top = _mm256_set1_epi32(area.y);
+    const __m256i bottom = _mm256_set1_epi32(area.y + area.h);
+
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i bx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i by = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        __m256i bw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        __m256i bh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+
+        __m256i overlap = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_add_epi32(bx, bw), left), _mm256_cmpgt_epi32(right, bx)),
+            _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_add_epi32(by, bh), top), _mm256_cmpgt_epi32(bottom, by)));
+
+        Uint64 bits = static_cast<Uint64>(_mm256_movemask_ps(_mm256_castsi256_ps(overlap)));
+        hits[i / 64] |= bits << (i % 64);
+        found += __builtin_popcountll(bits);
+    }
+
+    return found + scalarTail(area, x, y, w, h, i, count, hits);
+}
+#endif
+
+IntersectFn selectBackend(const char** name) {
+#if NINJUMP_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return intersectRectsAvx2;
+    }
+#endif
+#if NINJUMP_SSE2
+    *name = "sse2";
+    return intersectRectsSse2;
+#else
+    *name = "scalar";
+    return intersectRectsScalar;
+#endif
+}
+
+const char* backendName = nullptr;
+IntersectFn backend = selectBackend(&backendName);
+
+}
+
+size_t intersectRectsWide(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                          size_t count, Uint64* hits) {
+    return backend(area, x, y, w, h, count, hits);
+}
+
+size_t intersectRectsScalar(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                            size_t count, Uint64* hits) {
+    clearHits(hits, count);
+    return scalarTail(area, x, y, w, h, 0, count, hits);
+}
+
+const char* intersectRectsBackend() {
+    return backendName;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <SDL.h>
+
+inline bool checkCollision(const SDL_Rect& a, const SDL_Rect& b) {
+    return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
+}
+
+size_t intersectRectsScalar(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                            size_t count, Uint64* hits);
+size_t intersectRectsWide(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                          size_t count, Uint64* hits);
+
+// Tests area against count rectangles stored as parallel x/y/w/h arrays and
+// writes one bit per rectangle into hits (bit i % 64 of word i / 64), which
+// must hold (count + 63) / 64 words. Returns the number of hits. Uses AVX2
+// when the CPU has it, SSE2 otherwise on x86, and scalar code elsewhere;
+// runs shorter than one vector stay scalar to skip the dispatch.
+inline size_t intersectRects(const SDL_Rect& area, const int* x, const int* y, const int* w, const int* h,
+                             size_t count, Uint64* hits) {
+    if (count >= 8) {
+        return intersectRectsWide(area, x, y, w, h, count, hits);
+    }
+
+    Uint64 bits = 0;
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool hit = area.x < x[i] + w[i] && area.x + area.w > x[i] && area.y < y[i] + h[i] && area.y + area.h > y[i];
+        bits |= static_cast<Uint64>(hit) << i;
+        found += hit;
+    }
+    hits[0] = bits;
+    return found;
+}
+
+const char* intersectRectsBackend();
+
+inline int lowestSetBit(Uint64 word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
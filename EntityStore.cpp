@@ -0,0 +1,108 @@
+#include "EntityStore.h"
+
+namespace {
+const Uint32 NO_SLOT = 0xFFFFFFFFu;
+}
+
+EntityStore::EntityStore(int width, int height, size_t capacity) :
+    width(width), height(height),
+    x(capacity), y(capacity), prevY(capacity), lane(capacity), active(capacity), health(capacity),
+    inUse(capacity), generations(capacity), nextFree(capacity) {
+    clear();
+}
+
+EntityHandle EntityStore::spawn(int spawnX, int spawnY, Lane spawnLane, int spawnHealth) {
+    EntityHandle handle;
+    if (freeHead == NO_SLOT) {
+        handle.slot = NO_SLOT;
+        return handle;
+    }
+
+    Uint32 slot = freeHead;
+    freeHead = nextFree[slot];
+    inUse[slot] = 1;
+    used++;
+    if (slot >= highWater) highWater = slot + 1;
+
+    x[slot] = spawnX;
+    y[slot] = spawnY;
+    prevY[slot] = spawnY;
+    lane[slot] = spawnLane;
+    active[slot] = 1;
+    health[slot] = spawnHealth;
+
+    handle.slot = slot;
+    handle.generation = generations[slot];
+    return handle;
+}
+
+bool EntityStore::isValid(EntityHandle handle) const {
+    return handle.slot < inUse.size() && inUse[handle.slot] && generations[handle.slot] == handle.generation;
+}
+
+// Returns slots that gameplay deactivated this tick to the free list.
+void EntityStore::sweep() {
+    for (size_t i = 0; i < highWater; i++) {
+        if (inUse[i] && !active[i]) {
+            release(i);
+        }
+    }
+    while (highWater > 0 && !inUse[highWater - 1]) {
+        highWater--;
+    }
+}
+
+void EntityStore::clear() {
+    for (size_t i = 0; i < inUse.size(); i++) {
+        if (inUse[i]) generations[i]++;
+        inUse[i] = 0;
+        active[i] = 0;
+    }
+
+    // Thread the free list so the lowest slots are handed out first.
+    freeHead = inUse.empty() ? NO_SLOT : 0;
+    for (size_t i = 0; i < nextFree.size(); i++) {
+        nextFree[i] = i + 1 < nextFree.size() ? static_cast<Uint32>(i + 1) : NO_SLOT;
+    }
+    highWater = 0;
+    used = 0;
+}
+
+void EntityStore::release(size_t slot) {
+    inUse[slot] = 0;
+    active[slot] = 0;
+    generations[slot]++;
+    nextFree[slot] = freeHead;
+    freeHead = static_cast<Uint32>(slot);
+    used--;
+}
+
+EntityRing::EntityRing(int width, int height, size_t capacity) :
+    width(width), height(height),
+    x(capacity), y(capacity), prevY(capacity), lane(capacity), alpha(capacity),
+    mask(capacity - 1) {
+    SDL_assert((capacity & (capacity - 1)) == 0);
+}
+
+bool EntityRing::push(int spawnX, int spawnY, Lane spawnLane) {
+    if (full()) return false;
+
+    size_t s = slot(count);
+    x[s] = spawnX;
+    y[s] = spawnY;
+    prevY[s] = spawnY;
+    lane[s] = spawnLane;
+    alpha[s] = 255.0f;
+    count++;
+    return true;
+}
+
+void EntityRing::popFront() {
+    head = (head + 1) & mask;
+    count--;
+}
+
+void EntityRing::clear() {
+    head = 0;
+    count = 0;
+}
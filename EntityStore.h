@@ -0,0 +1,91 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+enum Lane : Uint8 { LANE_LEFT = 0, LANE_RIGHT = 1 };
+
+struct EntityHandle {
+    Uint32 slot = 0;
+    Uint32 generation = 0;
+};
+
+// Fixed-capacity structure-of-arrays pool for one kind of entity. Per-entity
+// fields live in parallel arrays indexed by slot, so update loops touch only
+// the fields they need. Slots are recycled through a free list threaded
+// through the pool itself; nothing is allocated after construction. Update
+// kernels may run over every slot below slotCount() and must gate on active.
+class EntityStore {
+public:
+    EntityStore(int width, int height, size_t capacity);
+
+    EntityHandle spawn(int x, int y, Lane lane, int health = 1);
+    bool isValid(EntityHandle handle) const;
+    void sweep();
+    void clear();
+
+    size_t slotCount() const { return highWater; }
+    size_t count() const { return used; }
+    size_t capacity() const { return y.size(); }
+    bool full() const { return used == y.size(); }
+    SDL_Rect rect(size_t i) const { return { x[i], y[i], width, height }; }
+
+    const int width;
+    const int height;
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> prevY;
+    std::vector<Uint8> lane;
+    std::vector<Uint8> active;
+    std::vector<int> health;
+
+private:
+    void release(size_t slot);
+
+    std::vector<Uint8> inUse;
+    std::vector<Uint32> generations;
+    std::vector<Uint32> nextFree;
+    Uint32 freeHead;
+    size_t highWater = 0;
+    size_t used = 0;
+};
+
+// Fixed-capacity structure-of-arrays ring for entities that are spawned at
+// the back and always retired from the front, in order. Logical index i maps
+// to physical slot slot(i); forEachSegment() yields the occupied physical
+// range as at most two contiguous spans for tight update loops.
+class EntityRing {
+public:
+    EntityRing(int width, int height, size_t capacity);
+
+    bool push(int x, int y, Lane lane);
+    void popFront();
+    void clear();
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == y.size(); }
+    size_t slot(size_t i) const { return (head + i) & mask; }
+    size_t frontSlot() const { return head; }
+    size_t backSlot() const { return slot(count - 1); }
+    SDL_Rect rect(size_t s) const { return { x[s], y[s], width, height }; }
+
+    template <typename Kernel>
+    void forEachSegment(Kernel kernel) {
+        size_t first = y.size() - head < count ? y.size() - head : count;
+        if (first > 0) kernel(head, head + first);
+        if (count > first) kernel(static_cast<size_t>(0), count - first);
+    }
+
+    const int width;
+    const int height;
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> prevY;
+    std::vector<Uint8> lane;
+    std::vector<float> alpha;
+
+private:
+    size_t mask;
+    size_t head = 0;
+    size_t count = 0;
+};
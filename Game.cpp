@@ -1,9 +1,13 @@
 #include "Game.h"
 #include "constants.h"
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
-Game::Game() {
+Game::Game() : nextRunSeed(mixSeed(SDL_GetPerformanceCounter())) {
     backgroundOffset = 0.0f;
+    prevBackgroundOffset = 0.0f;
 }
 
 Game::~Game() {
@@ -11,33 +15,184 @@ Game::~Game() {
 }
 
 bool Game::init() {
+    timeline.start();
     if (!initSDL()) return false;
+    timeline.mark("SDL init");
+
+    if (renderBackend == RenderBackend::CPU_RASTER) {
+        if (raster.init(renderer, SCREEN_WIDTH, SCREEN_HEIGHT, SoftwareRasterizer::defaultThreadCount())) {
+            text.setRasterizer(&raster);
+            sprites.setRasterizer(&raster);
+        } else {
+            renderBackend = RenderBackend::SOFTWARE;
+        }
+    }
 
-    font = TTF_OpenFont("PixelifySans.ttf", 36);
+    // Optional: without a pack every asset is read from loose files.
+    pack.open(PACK_FILE);
+    timeline.mark("resource pack");
+
+    if (!audio.isOpen()) {
+        openNullAudio();
+    }
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    if (!audio.isNull() && Mix_QuerySpec(&frequency, &format, &channels)) {
+        music.start(pack, frequency, channels);
+    }
+
+    font = TTF_OpenFontRW(pack.openAsset(FONT_FILE), 1, 36);
     if (!font) {
         std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
         return false;
     }
 
-    if (!loadResources()) {
+    if (!text.init(renderer, font)) {
+        return false;
+    }
+    timeline.mark("font");
+
+    if (!startLoading()) {
         return false;
     }
 
     highScore = loadHighScore();
+    timelinePending = true;
+    return true;
+}
+
+bool Game::initHeadless() {
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    headless = true;
+    replayPath.clear();
+    // Sounds are logged rather than played, so replays can check what would be
+    // heard. The log is only kept when main will write it out.
+    openNullAudio(SDL_getenv("NINJUMP_AUDIO_LOG") != nullptr);
     return true;
 }
 
 void Game::run() {
+    const double tickMs = 1000.0 / SIM_TICK_RATE;
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 previousCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+
     while (running) {
+        Uint64 currentCounter = SDL_GetPerformanceCounter();
+        double frameMs = (currentCounter - previousCounter) * 1000.0 / frequency;
+        previousCounter = currentCounter;
+
+        // Clamp long stalls (window drag, breakpoint) so we don't spiral catching up.
+        if (frameMs > MAX_FRAME_TIME_MS) frameMs = MAX_FRAME_TIME_MS;
+        accumulator += frameMs;
+
         handleEvents();
+
+        if (loader && loader->finished() && !finishLoading()) {
+            running = false;
+        }
+        // Printed once background loading has landed, so its spans are included;
+        // checked before the idle wait so a menu left alone still reports.
+        if (timelinePending && !loader && timeline.firstFrameShown()) {
+            timeline.print(std::cout);
+            resources.report(std::cout);
+            timelinePending = false;
+        }
+
+        if (audio.totalUnderruns() != reportedUnderruns) {
+            reportedUnderruns = audio.totalUnderruns();
+            std::cerr << "Audio underrun: " << audio.lastUnderrunGapMs() << " ms between callbacks with "
+                      << audioBufferFrames << "-frame buffers, " << audio.underruns() << " in the last "
+                      << AUDIO_UNDERRUN_WINDOW_MS / 1000 << " s" << std::endl;
+        }
+        // Background sound loads query the mixer device, so it is only
+        // reopened once finishLoading() has run.
+        if (!loader && audio.underruns() >= AUDIO_UNDERRUN_LIMIT && audioBufferFrames < AUDIO_MAX_BUFFER_FRAMES) {
+            growAudioBuffer();
+        }
+
+        // Menus and overlays only change on input, and a minimized window shows
+        // nothing: sleep in the event queue instead of redrawing at 60 Hz. Idle
+        // time is dropped rather than simulated, so game time stands still.
+        bool minimized = (SDL_GetWindowFlags(window) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)) != 0;
+        bool idle = gameState != GameState::PLAYING && !frameDirty;
+        if (running && (minimized || idle)) {
+            SDL_WaitEventTimeout(nullptr, IDLE_WAIT_MS);
+            previousCounter = SDL_GetPerformanceCounter();
+            continue;
+        }
+
+        while (accumulator >= tickMs) {
+            update();
+            accumulator -= tickMs;
+        }
+
+        // Pausing keeps the gameplay track going.
+        music.play(gameState == GameState::MENU ? MUSIC_MENU :
+                   gameState == GameState::GAME_OVER ? MUSIC_GAME_OVER : MUSIC_PLAYING);
+
+        updateScreenResources();
+        float interpolation = gameState == GameState::PLAYING ? static_cast<float>(accumulator / tickMs) : 1.0f;
+        render(interpolation);
+        frameDirty = false;
+
+        if (!timeline.firstFrameShown()) {
+            timeline.markFirstFrame();
+        }
+
+        if (!vsync) {
+            SDL_Delay(1);
+        }
+    }
+
+    endSession();
+    audio.reportLatency(std::cout, SOUND_JUMP);
+}
+
+void Game::runHeadless(Uint64 ticks) {
+    beginSession();
+    // Hashing and event capture are only paid for when the session is kept.
+    recordingActive = !replayPath.empty();
+
+    int runs = 1;
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 startCounter = SDL_GetPerformanceCounter();
+
+    for (Uint64 tick = 0; tick < ticks; ++tick) {
+        // Scripted input so jumps, shurikens and kills are all exercised.
+        if (tick % 45 == 0) {
+            applyInput(InputKey::SPACE);
+        }
+        if (tick % 20 == 0) {
+            applyInput(InputKey::S);
+        }
+
         update();
-        render();
-        SDL_Delay(16);
+
+        if (gameState == GameState::GAME_OVER) {
+            applyInput(InputKey::R);
+            runs++;
+        }
+    }
+
+    double seconds = static_cast<double>(SDL_GetPerformanceCounter() - startCounter) / frequency;
+    endSession();
+
+    std::cout << "Simulated " << ticks << " ticks (" << runs << " runs, "
+              << static_cast<double>(ticks) / SIM_TICK_RATE << " s of game time) in " << seconds << " s" << std::endl;
+    if (seconds > 0.0 && ticks > 0) {
+        std::cout << "ticks/sec: " << ticks / seconds << std::endl;
+        std::cout << "ns/tick: " << seconds * 1e9 / ticks << std::endl;
     }
 }
 
 bool Game::initSDL() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -52,87 +207,214 @@ bool Game::initSDL() {
         return false;
     }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cerr << "SDL_mixer initialization failed: " << Mix_GetError() << std::endl;
-        return false;
+    // Small buffers keep jump and hit sounds close to the frame that caused
+    // them; growAudioBuffer() backs off if this machine can't keep up.
+    int bufferFrames = AUDIO_BUFFER_FRAMES;
+    if (const char* frames = SDL_getenv("NINJUMP_AUDIO_FRAMES")) {
+        bufferFrames = std::max(64, std::min(AUDIO_MAX_BUFFER_FRAMES, std::atoi(frames)));
+    }
+    // NINJUMP_AUDIO=null skips the device, and machines without any audio
+    // driver still start; init() then falls back to null output.
+    const char* audioBackend = SDL_getenv("NINJUMP_AUDIO");
+    if (!(audioBackend && std::strcmp(audioBackend, "null") == 0)) {
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+            std::cerr << "SDL audio initialization failed: " << SDL_GetError() << std::endl;
+            std::cerr << "Continuing without sound" << std::endl;
+        } else if (!openAudio(bufferFrames)) {
+            std::cerr << "Continuing without sound" << std::endl;
+        }
     }
 
     window = SDL_CreateWindow("NinJump", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                             SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+                             SCREEN_WIDTH, SCREEN_HEIGHT, hiddenWindow ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
     if (!window) {
         std::cerr << "Window creation failed: " << SDL_GetError() << std::endl;
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (renderBackend == RenderBackend::GPU) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    }
+    if (!renderer) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!renderer) {
         std::cerr << "Renderer creation failed: " << SDL_GetError() << std::endl;
         return false;
     }
 
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        vsync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+        // No usable GPU: our rasterizer beats SDL's generic software path.
+        if (renderBackend == RenderBackend::GPU && (info.flags & SDL_RENDERER_SOFTWARE)) {
+            std::cerr << "No accelerated renderer, drawing gameplay on the CPU" << std::endl;
+            renderBackend = RenderBackend::CPU_RASTER;
+        }
+    }
+
     return true;
 }
 
-bool Game::loadResources() {
-    textures.background = loadTexture("background.png");
-    textures.ninja = loadTexture("ninja.png");
-    textures.wall = loadTexture("wall.png");
-    textures.platform = loadTexture("platform.png");
-    textures.heart = loadTexture("heart.gif");
-    textures.menu = loadTexture("menu.png");
-    textures.gameOver = loadTexture("background.png");
-    textures.pause = loadTexture("pause.png");
-    textures.shuriken = loadTexture("shuriken.png");
-    textures.enemy = loadTexture("enemy.png");
-
-    sounds.jump = Mix_LoadWAV("jump.wav");
-    sounds.hit = Mix_LoadWAV("hit.wav");
-    sounds.loseLife = Mix_LoadWAV("lose_life.wav");
-    sounds.gameOver = Mix_LoadWAV("game_over.wav");
-    sounds.kill[0] = Mix_LoadWAV("kill1.wav");
-    sounds.kill[1] = Mix_LoadWAV("kill2.wav");
-    sounds.kill[2] = Mix_LoadWAV("kill3.wav");
-    sounds.kill[3] = Mix_LoadWAV("kill4.wav");
-    sounds.kill[4] = Mix_LoadWAV("kill5.wav");
-    sounds.enemySpawn = Mix_LoadWAV("spawn.wav");
-
-    if (!textures.background || !textures.ninja || !textures.wall ||
-        !textures.platform || !textures.heart || !textures.menu ||
-        !textures.gameOver || !textures.pause ||
-        !sounds.jump || !sounds.hit || !sounds.loseLife || !sounds.gameOver ||
-        !sounds.kill || !sounds.enemySpawn) {
+bool Game::openAudio(int bufferFrames) {
+    audioBufferFrames = bufferFrames;
+    reportedUnderruns = 0;
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, bufferFrames) < 0) {
+        std::cerr << "SDL_mixer initialization failed: " << Mix_GetError() << std::endl;
         return false;
     }
+    return audio.open(bufferFrames, &music);
+}
 
-    return true;
+void Game::growAudioBuffer() {
+    int bufferFrames = audioBufferFrames * 2;
+    std::cerr << "Audio underruns with " << audioBufferFrames << "-frame buffers, reopening with "
+              << bufferFrames << std::endl;
+
+    // Sounds already decoded stay valid: the device format does not change.
+    audio.close();
+    Mix_CloseAudio();
+    if (!openAudio(bufferFrames)) {
+        std::cerr << "Continuing without sound" << std::endl;
+        music.stop();
+        openNullAudio();
+    }
 }
 
-void Game::cleanup() {
-    SDL_DestroyTexture(textures.background);
-    SDL_DestroyTexture(textures.ninja);
-    SDL_DestroyTexture(textures.shuriken);
-    SDL_DestroyTexture(textures.wall);
-    SDL_DestroyTexture(textures.platform);
-    SDL_DestroyTexture(textures.heart);
-    SDL_DestroyTexture(textures.menu);
-    SDL_DestroyTexture(textures.gameOver);
-    SDL_DestroyTexture(textures.pause);
-
-    Mix_FreeChunk(sounds.jump);
-    Mix_FreeChunk(sounds.hit);
-    Mix_FreeChunk(sounds.loseLife);
-    Mix_FreeChunk(sounds.gameOver);
-    SDL_DestroyTexture(textures.enemy);
+void Game::openNullAudio(bool recordEvents) {
+    Uint32 lengths[SOUND_COUNT];
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        lengths[i] = soundLength(pack, static_cast<SoundId>(i), AUDIO_FREQUENCY);
+    }
+    audio.openNull(lengths, recordEvents);
+}
+
+void Game::writeAudioLog(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write audio log: " << path << std::endl;
+        return;
+    }
+    audio.writeEvents(file);
+}
+
+bool Game::startLoading() {
+    imageFormat = nativeImageFormat(renderer);
+    premultipliedAlpha = supportsPremultipliedAlpha(renderer);
+
+    // Only the menu art is waited for here; everything else keeps decoding
+    // while the menu is up and is picked up by finishLoading().
+    loader.reset(new AssetLoader(pack, imageFormat, premultipliedAlpha, !audio.isNull()));
+    loader->start(AssetLoader::defaultWorkerCount());
+    resources.init(renderer, &pack, imageFormat, premultipliedAlpha);
+    if (const char* budgetMb = SDL_getenv("NINJUMP_RESOURCE_BUDGET_MB")) {
+        resources.setBudget(std::strtoull(budgetMb, nullptr, 10) * 1024 * 1024);
+    } else {
+        resources.setBudget(RESOURCE_BUDGET_BYTES);
+    }
+    resources.trackTexture("glyph atlas", text.texture());
+
+    // Without render targets the HUD is simply drawn every frame. The cached
+    // layer ends up premultiplied, so it also needs the premultiplied blend mode.
+    if (renderBackend != RenderBackend::CPU_RASTER && premultipliedAlpha && SDL_RenderTargetSupported(renderer)) {
+        hudLayer = SDL_CreateTexture(renderer, imageFormat, SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH,
+                                     50 + text.lineHeight());
+    }
+    if (hudLayer) {
+        // Drawing straight alpha over a cleared target leaves it premultiplied.
+        SDL_SetTextureBlendMode(hudLayer, premultipliedBlendMode());
+        resources.trackTexture("hud layer", hudLayer);
+    }
+
+    loader->wait(IMAGE_MENU);
+    textures.menu = resources.addTexture(IMAGE_MENU, loader->image(IMAGE_MENU), true);
+    timeline.mark("menu");
+
+    return textures.menu != nullptr;
+}
+
+bool Game::finishLoading() {
+    if (!loader) return true;
+
+    Uint64 begin = SDL_GetPerformanceCounter();
+    loader->finish();
+
+    const ImageId spriteImages[SPRITE_COUNT] = {
+        IMAGE_BACKGROUND, IMAGE_WALL, IMAGE_NINJA, IMAGE_SHURIKEN, IMAGE_ENEMY, IMAGE_PLATFORM, IMAGE_HEART
+    };
+    SDL_Surface* spriteSurfaces[SPRITE_COUNT] = {};
+    bool spritesLoaded = true;
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        spriteSurfaces[i] = loader->image(spriteImages[i]);
+        spritesLoaded = spritesLoaded && spriteSurfaces[i];
+    }
+    if (spritesLoaded) {
+        spritesLoaded = sprites.build(renderer, spriteSurfaces, premultipliedAlpha);
+    }
+
+    resources.trackTexture("sprite atlas", sprites.texture());
+
+    // Not on screen yet: the handle is dropped at once and the cache decides whether it stays.
+    bool pauseLoaded = resources.addTexture(IMAGE_PAUSE, loader->image(IMAGE_PAUSE), true) != nullptr;
+
+    sounds.jump = resources.addSound(SOUND_JUMP, loader->takeSound(SOUND_JUMP));
+    sounds.hit = resources.addSound(SOUND_HIT, loader->takeSound(SOUND_HIT));
+    sounds.loseLife = resources.addSound(SOUND_LOSE_LIFE, loader->takeSound(SOUND_LOSE_LIFE));
+    sounds.gameOver = resources.addSound(SOUND_GAME_OVER, loader->takeSound(SOUND_GAME_OVER));
+    bool killsLoaded = true;
+    for (int i = 0; i < 5; i++) {
+        SoundId kill = static_cast<SoundId>(SOUND_KILL_1 + i);
+        sounds.kill[i] = resources.addSound(kill, loader->takeSound(kill));
+        killsLoaded = killsLoaded && sounds.kill[i];
+    }
+    sounds.enemySpawn = resources.addSound(SOUND_ENEMY_SPAWN, loader->takeSound(SOUND_ENEMY_SPAWN));
+
+    audio.setSound(SOUND_JUMP, sounds.jump.get());
+    audio.setSound(SOUND_HIT, sounds.hit.get());
+    audio.setSound(SOUND_LOSE_LIFE, sounds.loseLife.get());
+    audio.setSound(SOUND_GAME_OVER, sounds.gameOver.get());
     for (int i = 0; i < 5; i++) {
-        Mix_FreeChunk(sounds.kill[i]);
+        audio.setSound(static_cast<SoundId>(SOUND_KILL_1 + i), sounds.kill[i].get());
+    }
+    audio.setSound(SOUND_ENEMY_SPAWN, sounds.enemySpawn.get());
+
+    loader->addToTimeline(timeline);
+    loader.reset();
+    timeline.addSpan("background assets to GPU", begin, SDL_GetPerformanceCounter(), 0);
+    resources.trim();
+
+    bool soundsLoaded = sounds.jump && sounds.hit && sounds.loseLife && sounds.gameOver &&
+                        killsLoaded && sounds.enemySpawn;
+    if (!spritesLoaded || !pauseLoaded || (!soundsLoaded && !audio.isNull())) {
+        return false;
     }
-    Mix_FreeChunk(sounds.enemySpawn);
 
+    return true;
+}
+
+void Game::cleanup() {
+    if (headless) {
+        SDL_Quit();
+        return;
+    }
+
+    loader.reset();
+    textures = GameTextures();
+    audio.close();
+    music.stop();
+    sounds = GameSounds();
+    resources.clear();
+
+    text.destroy();
+    sprites.destroy();
+    raster.destroy();
+    SDL_DestroyTexture(hudLayer);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
 
     TTF_CloseFont(font);
 
+    Mix_CloseAudio();
     Mix_Quit();
     TTF_Quit();
     IMG_Quit();
@@ -140,113 +422,159 @@ void Game::cleanup() {
 }
 
 void Game::handleShurikens() {
-    for (auto& shuriken : player.shurikens) {
-        shuriken.update();
-    }
-
-    player.shurikens.erase(
-        std::remove_if(player.shurikens.begin(), player.shurikens.end(),
-            [](const Shuriken& s) { return !s.isActive(); }),
-        player.shurikens.end());
+    Shuriken::update(player.shurikens);
+    player.shurikens.sweep();
 }
 
 void Game::handleEnemies() {
     spawnEnemies();
 
-    for (auto& enemy : enemies) {
-        enemy.update(platformSpeed);
+    Enemy::update(enemies, platformSpeed);
+
+    enemyGrid.clear();
+    for (size_t e = 0; e < enemies.slotCount(); e++) {
+        if (enemies.active[e]) {
+            enemyGrid.insert(enemies.rect(e), static_cast<Lane>(enemies.lane[e]), static_cast<Uint32>(e));
+        }
     }
+    enemyGrid.build();
 
-    for (auto& shuriken : player.shurikens) {
-        if (!shuriken.isActive()) continue;
+    EntityStore& shurikens = player.shurikens;
+    for (size_t s = 0; s < shurikens.slotCount(); s++) {
+        if (!shurikens.active[s]) continue;
 
-        for (auto& enemy : enemies) {
-            if (enemy.isActive() && checkCollision(shuriken.getRect(), enemy.getRect())) {
-                shuriken.deactivate();
-                enemy.takeDamage();
-                if (enemy.isDead()) {
+        enemyGrid.query(shurikens.rect(s), [&](Uint32 e) {
+            if (enemies.active[e]) {
+                shurikens.active[s] = 0;
+                Enemy::takeDamage(enemies, e);
+                if (Enemy::isDead(enemies, e)) {
                     updateKillStreak(true);
                     player.score += 10;
                 }
             }
-        }
+            return false;
+        });
     }
 
-    for (auto& enemy : enemies) {
-        if (enemy.isActive() && checkCollision(player.getRect(), enemy.getRect())) {
-            if (!player.isInvincible) {
-                player.lives--;
-                player.isInvincible = true;
-                player.invincibleTime = SDL_GetTicks() + PLAYER_INVINCIBLE_TIME;
+    if (!player.isInvincible) {
+        enemyGrid.query(player.getRect(), [&](Uint32 e) {
+            if (!enemies.active[e]) return false;
 
-                Mix_PlayChannel(-1, sounds.hit, 0);
+            player.lives--;
+            player.isInvincible = true;
+            player.invincibleTime = clock.now() + PLAYER_INVINCIBLE_TIME;
 
-                if (player.lives <= 0) {
-                    Mix_PlayChannel(-1, sounds.gameOver, 0);
-                    gameState = GameState::GAME_OVER;
-                }
+            playSound(SOUND_HIT);
+
+            if (player.lives <= 0) {
+                playSound(SOUND_GAME_OVER);
+                gameState = GameState::GAME_OVER;
             }
+            return true;
+        });
+    }
+
+    enemies.sweep();
+}
+
+bool Game::playReplay(const Replay& replay) {
+    setSeed(replay.seed);
+    beginSession();
+
+    size_t nextEvent = 0;
+    size_t nextCheckpoint = 0;
+    for (Uint32 tick = 0; tick < replay.tickCount; ++tick) {
+        while (nextEvent < replay.events.size() && replay.events[nextEvent].tick == tick) {
+            applyInput(replay.events[nextEvent++].key);
+        }
+
+        update();
+
+        if (recording.checkpoints.size() > nextCheckpoint) {
+            if (nextCheckpoint >= replay.checkpoints.size() ||
+                recording.checkpoints[nextCheckpoint] != replay.checkpoints[nextCheckpoint]) {
+                std::cerr << "Replay diverged by tick " << tick + 1 << std::endl;
+                recordingActive = false;
+                return false;
+            }
+            nextCheckpoint++;
         }
     }
 
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [](const Enemy& e) { return !e.isActive(); }),
-        enemies.end());
+    recordingActive = false;
+    return nextCheckpoint == replay.checkpoints.size();
+}
+
+double Game::benchmarkReplay(const Replay& replay, Uint32 maxFrames) {
+    if (!finishLoading()) return -1.0;
+
+    setSeed(replay.seed);
+    beginSession();
+    recordingActive = false;
+
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 renderCounts = 0;
+    Uint32 frames = std::min(replay.tickCount, maxFrames);
+    size_t nextEvent = 0;
+    for (Uint32 tick = 0; tick < frames; ++tick) {
+        while (nextEvent < replay.events.size() && replay.events[nextEvent].tick == tick) {
+            applyInput(replay.events[nextEvent++].key);
+        }
+        update();
+        updateScreenResources();
+
+        Uint64 startCounter = SDL_GetPerformanceCounter();
+        render(1.0f);
+        renderCounts += SDL_GetPerformanceCounter() - startCounter;
+    }
+
+    return frames ? renderCounts * 1000.0 / frequency / frames : 0.0;
+}
+
+void Game::setRenderBackend(RenderBackend backend, bool hidden) {
+    renderBackend = backend;
+    hiddenWindow = hidden;
 }
 
 void Game::handleEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        frameDirty = true;
         if (event.type == SDL_QUIT) {
             running = false;
         }
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            hudLives = -1;
+        }
 
         switch (gameState) {
             case GameState::MENU:
                 if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_KEYDOWN) {
-                    gameState = GameState::PLAYING;
-                    player.reset();
-                    platforms.clear();
-                    platforms.emplace_back(WALL_WIDTH, player.y - SCREEN_HEIGHT);
-                    platformSpeed = INITIAL_PLATFORM_SPEED;
-                }
-                break;
-
-            case GameState::PLAYING:
-                if (event.type == SDL_KEYDOWN) {
-                    if (event.key.keysym.sym == SDLK_SPACE) {
-                        player.jump(sounds);
-                    } else if (event.key.keysym.sym == SDLK_ESCAPE) {
-                        gameState = GameState::PAUSED;
-                    } else if (event.key.keysym.sym == SDLK_s) {
-                        player.throwShuriken();
+                    // A tap before background loading is done waits on it here.
+                    if (!finishLoading()) {
+                        running = false;
+                        break;
                     }
+                    beginSession();
                 }
                 break;
 
+            case GameState::PLAYING:
             case GameState::PAUSED:
-                if (event.type == SDL_KEYDOWN) {
-                    if (event.key.keysym.sym == SDLK_ESCAPE) {
-                        gameState = GameState::PLAYING;
-                    } else if (event.key.keysym.sym == SDLK_m) {
-                        gameState = GameState::MENU;
-                    }
-                }
-                break;
-
             case GameState::GAME_OVER:
                 if (event.type == SDL_KEYDOWN) {
-                    if (event.key.keysym.sym == SDLK_r) {
-                        gameState = GameState::PLAYING;
-                        player.reset();
-                        platforms.clear();
-                        platforms.emplace_back(WALL_WIDTH, player.y - SCREEN_HEIGHT);
-                        platformSpeed = INITIAL_PLATFORM_SPEED;
-                    } else if (event.key.keysym.sym == SDLK_m) {
-                        gameState = GameState::MENU;
-                    } else if (event.key.keysym.sym == SDLK_ESCAPE) {
-                        running = false;
+                    switch (event.key.keysym.sym) {
+                        case SDLK_SPACE: applyInput(InputKey::SPACE); break;
+                        case SDLK_s: applyInput(InputKey::S); break;
+                        case SDLK_ESCAPE: applyInput(InputKey::ESCAPE); break;
+                        case SDLK_r: applyInput(InputKey::R); break;
+                        case SDLK_m:
+                            if (gameState != GameState::PLAYING) {
+                                endSession();
+                                gameState = GameState::MENU;
+                            }
+                            break;
+                        default: break;
                     }
                 }
                 break;
@@ -257,8 +585,117 @@ void Game::handleEvents() {
     }
 }
 
+void Game::applyInput(InputKey key) {
+    if (recordingActive) {
+        recording.events.push_back({ recording.tickCount, key });
+    }
+
+    switch (gameState) {
+        case GameState::PLAYING:
+            if (key == InputKey::SPACE) {
+                if (player.jump()) {
+                    playSound(SOUND_JUMP);
+                }
+            } else if (key == InputKey::ESCAPE) {
+                gameState = GameState::PAUSED;
+            } else if (key == InputKey::S) {
+                player.throwShuriken();
+            }
+            break;
+
+        case GameState::PAUSED:
+            if (key == InputKey::ESCAPE) {
+                gameState = GameState::PLAYING;
+            }
+            break;
+
+        case GameState::GAME_OVER:
+            if (key == InputKey::R) {
+                startNewGame();
+            } else if (key == InputKey::ESCAPE) {
+                running = false;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void Game::beginSession() {
+    clock = VirtualClock();
+    recording.clear();
+    recording.seed = nextRunSeed;
+    recordingActive = true;
+    stateHash = 2166136261u;
+    startNewGame();
+}
+
+void Game::endSession() {
+    if (!recordingActive) return;
+    recordingActive = false;
+
+    if (!replayPath.empty() && !recording.save(replayPath)) {
+        std::cerr << "Failed to save replay: " << replayPath << std::endl;
+    }
+}
+
+Uint32 Game::hashState(Uint32 hash) const {
+    int playerState[] = { player.x, player.y, player.lives, player.score, player.isInvincible,
+                          static_cast<int>(gameState), killStreak };
+    hash = hashBytes(hash, playerState, sizeof(playerState));
+    hash = hashBytes(hash, &player.velocityY, sizeof(player.velocityY));
+    hash = hashBytes(hash, &player.scoreMultiplier, sizeof(player.scoreMultiplier));
+    hash = hashBytes(hash, &platformSpeed, sizeof(platformSpeed));
+
+    for (size_t i = 0; i < platforms.size(); i++) {
+        SDL_Rect rect = platforms.rect(platforms.slot(i));
+        hash = hashBytes(hash, &rect, sizeof(rect));
+    }
+    for (size_t i = 0; i < enemies.slotCount(); i++) {
+        if (!enemies.active[i]) continue;
+        SDL_Rect rect = enemies.rect(i);
+        hash = hashBytes(hash, &rect, sizeof(rect));
+    }
+    for (size_t i = 0; i < player.shurikens.slotCount(); i++) {
+        if (!player.shurikens.active[i]) continue;
+        SDL_Rect rect = player.shurikens.rect(i);
+        hash = hashBytes(hash, &rect, sizeof(rect));
+    }
+    return hash;
+}
+
+void Game::setSeed(Uint64 seed) {
+    nextRunSeed = seed;
+}
+
+void Game::setReplayPath(const std::string& path) {
+    replayPath = path;
+}
+
+void Game::startNewGame() {
+    runSeed = nextRunSeed;
+    nextRunSeed = mixSeed(nextRunSeed);
+    rng.seed(runSeed);
+
+    gameState = GameState::PLAYING;
+    player.reset(clock.now());
+    player.shurikens.clear();
+    platforms.clear();
+    Platform::spawn(platforms, WALL_WIDTH, player.y - SCREEN_HEIGHT);
+    enemies.clear();
+    platformSpeed = INITIAL_PLATFORM_SPEED;
+    killStreak = 0;
+    lastKillTime = clock.now();
+    lastSpawnTime = clock.now();
+}
+
+void Game::playSound(SoundId sound) {
+    audio.play(sound);
+}
+
 void Game::updateKillStreak(bool killedEnemy) {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = clock.now();
 
     if (killedEnemy) {
         if (currentTime - lastKillTime > 4000) {
@@ -269,7 +706,7 @@ void Game::updateKillStreak(bool killedEnemy) {
         lastKillTime = currentTime;
 
         if (killStreak > 0 && killStreak <= 5) {
-            Mix_PlayChannel(-1, sounds.kill[killStreak-1], 0);
+            playSound(static_cast<SoundId>(SOUND_KILL_1 + killStreak - 1));
         }
     }
     else if (currentTime - lastKillTime > 2000) {
@@ -278,30 +715,43 @@ void Game::updateKillStreak(bool killedEnemy) {
 }
 
 void Game::update() {
+    clock.advance();
+
     if (gameState == GameState::PLAYING) {
-        player.update();
+        player.update(clock.now());
+
+        Platform::update(platforms, platformSpeed);
 
-        for (auto& platform : platforms) {
-            platform.update(platformSpeed);
+        bool hitPlatform = false;
+        if (!player.isInvincible) {
+            // Ring order is oldest (lowest on screen) first; insert newest first so each lane arrives sorted.
+            platformGrid.clear();
+            for (size_t i = platforms.size(); i-- > 0;) {
+                size_t slot = platforms.slot(i);
+                platformGrid.insert(platforms.rect(slot), static_cast<Lane>(platforms.lane[slot]), static_cast<Uint32>(slot));
+            }
+            platformGrid.build();
+
+            platformGrid.query(player.getRect(), [&](Uint32) {
+                hitPlatform = true;
+                return true;
+            });
         }
 
-        for (auto& platform : platforms) {
-            if (!player.isInvincible && checkCollision(player.getRect(), platform.rect)) {
-                Mix_PlayChannel(-1, sounds.hit, 0);
-                player.lives--;
-
-                if (player.lives > 0) {
-                    Mix_PlayChannel(-1, sounds.loseLife, 0);
-                    player.resetPosition();
-                } else {
-                    Mix_PlayChannel(-1, sounds.gameOver, 0);
-                    if (player.score > highScore) {
-                        highScore = player.score;
-                        saveHighScore(highScore);
-                    }
-                    gameState = GameState::GAME_OVER;
+        if (hitPlatform) {
+            playSound(SOUND_HIT);
+            player.lives--;
+
+            if (player.lives > 0) {
+                playSound(SOUND_LOSE_LIFE);
+                player.resetPosition(clock.now());
+            } else {
+                playSound(SOUND_GAME_OVER);
+                if (!headless && player.score > highScore) {
+                    highScore = player.score;
+                    saveHighScore(highScore);
                 }
-                break;
+                gameState = GameState::GAME_OVER;
             }
         }
 
@@ -310,62 +760,57 @@ void Game::update() {
         handleEnemies();
         updateKillStreak(false);
 
-        if (!platforms.empty() && platforms.front().rect.y > SCREEN_HEIGHT) {
-            platforms.erase(platforms.begin());
+        if (!platforms.empty() && platforms.y[platforms.frontSlot()] > SCREEN_HEIGHT) {
+            platforms.popFront();
         }
 
         if (platformSpeed < MAX_PLATFORM_SPEED) {
             platformSpeed += SPEED_INCREASE_RATE;
         }
 
+        prevBackgroundOffset = backgroundOffset;
         backgroundOffset += BACKGROUND_SCROLL_SPEED;
         if (backgroundOffset >= SCREEN_HEIGHT) {
             backgroundOffset -= SCREEN_HEIGHT;
         }
     }
-}
-
-void Game::render() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
 
-    SDL_Rect bgRect1 = {
-        0,
-        static_cast<int>(backgroundOffset) - SCREEN_HEIGHT,
-        SCREEN_WIDTH,
-        SCREEN_HEIGHT
-    };
-
-    SDL_Rect bgRect2 = {
-        0,
-        static_cast<int>(backgroundOffset),
-        SCREEN_WIDTH,
-        SCREEN_HEIGHT
-    };
-
-    SDL_RenderCopy(renderer, textures.background, nullptr, &bgRect1);
-    SDL_RenderCopy(renderer, textures.background, nullptr, &bgRect2);
+    if (recordingActive) {
+        stateHash = hashState(stateHash);
+        if (++recording.tickCount % REPLAY_CHECKPOINT_INTERVAL == 0) {
+            recording.checkpoints.push_back(stateHash);
+        }
+    }
 
-    SDL_Rect leftWall = { 0, 0, WALL_WIDTH, SCREEN_HEIGHT };
-    SDL_Rect rightWall = { SCREEN_WIDTH - WALL_WIDTH, 0, WALL_WIDTH, SCREEN_HEIGHT };
-    SDL_RenderCopy(renderer, textures.wall, nullptr, &leftWall);
-    SDL_RenderCopy(renderer, textures.wall, nullptr, &rightWall);
+    // Numbered like replay input: the tick that just ran.
+    audio.endTick(clock.tick() - 1);
+}
 
-    for (auto& shuriken : player.shurikens) {
-        shuriken.render(renderer, textures.shuriken);
+void Game::render(float interpolation) {
+    // Static screens are a single copy, so only gameplay frames go through the rasterizer.
+    bool cpuFrame = renderBackend == RenderBackend::CPU_RASTER &&
+                    (gameState == GameState::PLAYING || gameState == GameState::GAME_OVER);
+    if (cpuFrame) {
+        raster.begin(0xFF000000);
+    } else {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
     }
 
-    for (auto& enemy : enemies) {
-        enemy.render(renderer, textures.enemy);
-    }
+    // The menu, pause and game-over art are opaque and full-screen, so the
+    // world under them is only drawn while playing.
+    if (gameState == GameState::PLAYING) {
+        renderBackground(interpolation);
 
-    for (auto& platform : platforms) {
-        platform.render(renderer, textures.platform);
-    }
+        Shuriken::render(player.shurikens, sprites, interpolation);
+        Enemy::render(enemies, sprites, interpolation);
+        Platform::render(platforms, sprites, interpolation);
 
-    player.render(renderer, textures.ninja);
+        player.render(sprites, interpolation);
+
+        // Background, walls and entities all come from the sprite atlas: one draw call.
+        sprites.flush();
 
-    if (gameState == GameState::PLAYING) {
         renderHUD();
     }
 
@@ -386,58 +831,70 @@ void Game::render() {
             break;
     }
 
+    text.flush();
+    if (cpuFrame) {
+        raster.present();
+    }
     SDL_RenderPresent(renderer);
 }
 
-void Game::renderText(SDL_Renderer* renderer, const std::string& text, SDL_Color color, int x, int y) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!surface) return;
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!texture) return;
-
-    int texW = 0, texH = 0;
-    SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH);
-    SDL_Rect dstrect = { x, y, texW, texH };
-    SDL_RenderCopy(renderer, texture, nullptr, &dstrect);
-    SDL_DestroyTexture(texture);
+void Game::renderText(const char* str, SDL_Color color, int x, int y) {
+    text.draw(str, color, x, y);
 }
 
-void Game::renderCenteredText(const std::string& text, SDL_Color color, int yOffset) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!surface) return;
+void Game::renderCenteredText(const char* str, SDL_Color color, int yOffset) {
+    text.draw(str, color, (SCREEN_WIDTH - text.measure(str))/2, SCREEN_HEIGHT/2 + yOffset);
+}
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!texture) return;
+void Game::renderBackground(float interpolation) {
+    float offsetDelta = backgroundOffset - prevBackgroundOffset;
+    if (offsetDelta < 0) offsetDelta += SCREEN_HEIGHT;
+    float drawOffset = prevBackgroundOffset + offsetDelta * interpolation;
+    if (drawOffset >= SCREEN_HEIGHT) drawOffset -= SCREEN_HEIGHT;
+    int offset = static_cast<int>(drawOffset);
+
+    // The atlas cell is the background already at window size, so scrolling
+    // is a wrapped pair of source rects. Only the strip between the walls is
+    // copied; nothing is drawn twice.
+    const int stripWidth = SCREEN_WIDTH - 2 * WALL_WIDTH;
+    if (offset > 0) {
+        SDL_Rect source = { WALL_WIDTH, SCREEN_HEIGHT - offset, stripWidth, offset };
+        SDL_Rect dest = { WALL_WIDTH, 0, stripWidth, offset };
+        sprites.drawRegion(SPRITE_BACKGROUND, source, dest);
+    }
+    SDL_Rect source = { WALL_WIDTH, 0, stripWidth, SCREEN_HEIGHT - offset };
+    SDL_Rect dest = { WALL_WIDTH, offset, stripWidth, SCREEN_HEIGHT - offset };
+    sprites.drawRegion(SPRITE_BACKGROUND, source, dest);
 
-    int texW, texH;
-    SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH);
-    SDL_Rect dstrect = { (SCREEN_WIDTH - texW)/2, SCREEN_HEIGHT/2 + yOffset, texW, texH };
-    SDL_RenderCopy(renderer, texture, nullptr, &dstrect);
-    SDL_DestroyTexture(texture);
+    SDL_Rect leftWall = { 0, 0, WALL_WIDTH, SCREEN_HEIGHT };
+    SDL_Rect rightWall = { SCREEN_WIDTH - WALL_WIDTH, 0, WALL_WIDTH, SCREEN_HEIGHT };
+    sprites.draw(SPRITE_WALL, leftWall);
+    sprites.draw(SPRITE_WALL, rightWall);
 }
 
 void Game::renderMenu() {
-    SDL_RenderCopy(renderer, textures.menu, nullptr, nullptr);
+    SDL_RenderCopy(renderer, textures.menu.get(), nullptr, nullptr);
 
     if (highScore > 0) {
-        renderCenteredText("HIGH SCORE: " + std::to_string(highScore), {255, 215, 0, 255}, -100);
+        char line[32];
+        std::snprintf(line, sizeof(line), "HIGH SCORE: %d", highScore);
+        renderCenteredText(line, {255, 215, 0, 255}, -100);
     }
 }
 
 void Game::renderPause() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-    SDL_Rect overlay = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderFillRect(renderer, &overlay);
-    SDL_RenderCopy(renderer, textures.pause, nullptr, nullptr);
+    SDL_RenderCopy(renderer, textures.pause.get(), nullptr, nullptr);
 }
 
 void Game::renderGameOver() {
-    SDL_RenderCopy(renderer, textures.gameOver, nullptr, nullptr);
+    // Same art as the scrolling background, so it comes from the atlas rather than a second texture.
+    SDL_Rect screen = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    sprites.draw(SPRITE_BACKGROUND, screen);
+    sprites.flush();
 
-    renderCenteredText("SCORE: " + std::to_string(player.score), {0, 0, 0, 255}, -50);
+    char line[32];
+    std::snprintf(line, sizeof(line), "SCORE: %d", player.score);
+    renderCenteredText(line, {0, 0, 0, 255}, -50);
 
     if (player.score == highScore) {
         renderCenteredText("NEW HIGH SCORE!", {255, 215, 0, 255}, 0);
@@ -449,43 +906,69 @@ void Game::renderGameOver() {
 }
 
 void Game::renderHUD() {
+    if (!hudLayer) {
+        drawHUD();
+        sprites.flush();
+        return;
+    }
+
+    // Lives and score change a handful of times per run; redraw the layer only then.
+    if (player.lives != hudLives || player.score != hudScore) {
+        hudLives = player.lives;
+        hudScore = player.score;
+
+        SDL_SetRenderTarget(renderer, hudLayer);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        drawHUD();
+        sprites.flush();
+        text.flush();
+        SDL_SetRenderTarget(renderer, nullptr);
+    }
+
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(hudLayer, nullptr, nullptr, &width, &height);
+    SDL_Rect dest = { 0, 0, width, height };
+    SDL_RenderCopy(renderer, hudLayer, nullptr, &dest);
+}
+
+void Game::drawHUD() {
     for (int i = 0; i < player.lives; ++i) {
         SDL_Rect heartRect = { 10 + i * (HEART_SIZE + HEART_PADDING), 10, HEART_SIZE, HEART_SIZE };
-        SDL_RenderCopy(renderer, textures.heart, nullptr, &heartRect);
+        sprites.draw(SPRITE_HEART, heartRect);
     }
-    renderText(renderer, "Score: " + std::to_string(player.score), {0, 0, 0, 255}, 10, 50);
+    char line[32];
+    std::snprintf(line, sizeof(line), "Score: %d", player.score);
+    renderText(line, {0, 0, 0, 255}, 10, 50);
 }
 
 void Game::spawnPlatform() {
-    if (platforms.empty() || platforms.back().rect.y > rand() % PLATFORM_SPAWN_GAP_MIN + PLATFORM_SPAWN_GAP_MAX) {
-        bool leftSide = (rand() % 2 == 0);
+    if (platforms.empty() || platforms.y[platforms.backSlot()] > static_cast<int>(rng.platforms.below(PLATFORM_SPAWN_GAP_MIN)) + PLATFORM_SPAWN_GAP_MAX) {
+        bool leftSide = rng.platforms.chance();
         int x = leftSide ? WALL_WIDTH : SCREEN_WIDTH - WALL_WIDTH - PLATFORM_WIDTH;
-        int y = platforms.empty() ? SCREEN_HEIGHT : platforms.back().rect.y - (rand() % PLATFORM_SPAWN_RANGE_MIN + PLATFORM_SPAWN_RANGE_MAX);
-        platforms.emplace_back(x, y);
+        int y = platforms.empty() ? SCREEN_HEIGHT : platforms.y[platforms.backSlot()] - (static_cast<int>(rng.platforms.below(PLATFORM_SPAWN_RANGE_MIN)) + PLATFORM_SPAWN_RANGE_MAX);
+        Platform::spawn(platforms, x, y);
     }
 }
 
 void Game::spawnEnemies() {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = clock.now();
     if (currentTime - lastSpawnTime > SPAWN_INTERVAL) {
         lastSpawnTime = currentTime;
 
-        int enemyCount = 1 + rand() % 5;
+        int enemyCount = 1 + static_cast<int>(rng.enemies.below(5));
         for (int i = 0; i < enemyCount; i++) {
-            bool leftSide = rand() % 2 == 0;
+            bool leftSide = rng.enemies.chance();
             int x = leftSide ? WALL_WIDTH : SCREEN_WIDTH - WALL_WIDTH - ENEMY_WIDTH;
             int y = -ENEMY_HEIGHT - (i * 50);
-            enemies.emplace_back(x, y, leftSide);
+            Enemy::spawn(enemies, x, y, leftSide);
         }
 
-        Mix_PlayChannel(-1, sounds.enemySpawn, 0);
+        playSound(SOUND_ENEMY_SPAWN);
     }
 }
 
-bool Game::checkCollision(const SDL_Rect& a, const SDL_Rect& b) {
-    return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
-}
-
 int Game::loadHighScore() {
     int highScore = 0;
     std::ifstream file(HIGH_SCORE_FILE, std::ios::binary);
@@ -504,19 +987,14 @@ void Game::saveHighScore(int score) {
     }
 }
 
-SDL_Texture* Game::loadTexture(const std::string& path) {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        std::cerr << "Failed to load image: " << path << " - " << IMG_GetError() << std::endl;
-        return nullptr;
-    }
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-
-    if (!texture) {
-        std::cerr << "Failed to create texture: " << path << " - " << SDL_GetError() << std::endl;
+void Game::updateScreenResources() {
+    bool wantMenu = gameState == GameState::MENU;
+    bool wantPause = gameState == GameState::PAUSED;
+    if (wantMenu == static_cast<bool>(textures.menu) && wantPause == static_cast<bool>(textures.pause)) {
+        return;
     }
 
-    return texture;
+    textures.menu = wantMenu ? resources.texture(IMAGE_MENU, true) : nullptr;
+    textures.pause = wantPause ? resources.texture(IMAGE_PAUSE, true) : nullptr;
+    resources.trim();
 }
@@ -7,22 +7,50 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include "Player.h"
+#include "Clock.h"
+#include "Random.h"
+#include "Replay.h"
 #include "GameTextures.h"
 #include "GameSounds.h"
 #include "Platform.h"
 #include "constants.h"
 #include "enemy.h"
+#include "Broadphase.h"
+#include "TextRenderer.h"
+#include "SpriteBatch.h"
+#include "Assets.h"
+#include "ResourcePack.h"
+#include "StartupTimeline.h"
+#include "AssetLoader.h"
+#include "ResourceManager.h"
+#include "SoftwareRasterizer.h"
+#include "AudioMixer.h"
+#include "MusicStream.h"
 
 enum class GameState { MENU, PLAYING, PAUSED, GAME_OVER, QUIT };
 
+// GPU is the normal SDL renderer; SOFTWARE forces SDL's generic software
+// renderer; CPU_RASTER draws gameplay frames with SoftwareRasterizer and uses
+// SDL's software renderer only to show them and the static screens.
+enum class RenderBackend { GPU, SOFTWARE, CPU_RASTER };
+
 class Game {
 public:
     Game();
     ~Game();
 
     bool init();
+    bool initHeadless();
     void run();
+    void runHeadless(Uint64 ticks);
+    bool playReplay(const Replay& replay);
+    double benchmarkReplay(const Replay& replay, Uint32 maxFrames);
+    void setRenderBackend(RenderBackend backend, bool hidden = false);
+    void setSeed(Uint64 seed);
+    void setReplayPath(const std::string& path);
+    void writeAudioLog(const std::string& path) const;
     void handleShurikens();
     void handleEnemies();
     void spawnEnemies();
@@ -30,39 +58,83 @@ public:
 
 private:
     bool initSDL();
-    bool loadResources();
+    bool openAudio(int bufferFrames);
+    void growAudioBuffer();
+    void openNullAudio(bool recordEvents = false);
+    bool startLoading();
+    bool finishLoading();
     void cleanup();
     void handleEvents();
+    void applyInput(InputKey key);
+    void beginSession();
+    void endSession();
+    Uint32 hashState(Uint32 hash) const;
+    void startNewGame();
+    void playSound(SoundId sound);
     void update();
-    void render();
-    void renderText(SDL_Renderer* renderer, const std::string& text, SDL_Color color, int x, int y);
-    void renderCenteredText(const std::string& text, SDL_Color color, int yOffset);
+    void updateScreenResources();
+    void render(float interpolation);
+    void renderBackground(float interpolation);
+    void renderText(const char* text, SDL_Color color, int x, int y);
+    void renderCenteredText(const char* text, SDL_Color color, int yOffset);
     void renderMenu();
     void renderPause();
     void renderGameOver();
     void renderHUD();
+    void drawHUD();
     void spawnPlatform();
-    bool checkCollision(const SDL_Rect& a, const SDL_Rect& b);
     int loadHighScore();
     void saveHighScore(int score);
 
-    SDL_Texture* loadTexture(const std::string& path);
+    ResourcePack pack;
+    StartupTimeline timeline;
+    bool timelinePending = false;
+    std::unique_ptr<AssetLoader> loader;
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
     TTF_Font* font = nullptr;
+    TextRenderer text;
+    SpriteBatch sprites;
+    SoftwareRasterizer raster;
+    RenderBackend renderBackend = RenderBackend::GPU;
+    bool hiddenWindow = false;
+    SDL_Texture* hudLayer = nullptr;
+    int hudLives = -1;
+    int hudScore = -1;
+    ResourceManager resources;
     GameTextures textures;
+    Uint32 imageFormat = SDL_PIXELFORMAT_ARGB8888;
+    bool premultipliedAlpha = false;
     GameSounds sounds;
+    MusicStream music;
+    AudioMixer audio;
+    int audioBufferFrames = AUDIO_BUFFER_FRAMES;
+    int reportedUnderruns = 0;
     Player player;
-    std::vector<Platform> platforms;
+    EntityRing platforms{PLATFORM_WIDTH, PLATFORM_HEIGHT, MAX_PLATFORMS};
+    VirtualClock clock;
+    Uint64 nextRunSeed;
+    Uint64 runSeed = 0;
+    RandomStreams rng;
+    Replay recording;
+    bool recordingActive = false;
+    std::string replayPath = REPLAY_FILE;
+    Uint32 stateHash = 0;
     GameState gameState = GameState::MENU;
     float platformSpeed = INITIAL_PLATFORM_SPEED;
     int highScore = 0;
     bool running = true;
-    std::vector<Enemy> enemies;
-    int killStreak;
-    Uint32 lastKillTime;
-    Uint32 lastSpawnTime;
+    bool frameDirty = true;
+    bool vsync = false;
+    bool headless = false;
+    EntityStore enemies{ENEMY_WIDTH, ENEMY_HEIGHT, MAX_ENEMIES};
+    LaneBroadphase platformGrid{MAX_PLATFORMS};
+    LaneBroadphase enemyGrid{MAX_ENEMIES};
+    int killStreak = 0;
+    Uint32 lastKillTime = 0;
+    Uint32 lastSpawnTime = 0;
     const Uint32 SPAWN_INTERVAL = 5000;
     float backgroundOffset;
+    float prevBackgroundOffset;
     const float BACKGROUND_SCROLL_SPEED = 0.5f;
 };
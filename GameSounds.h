@@ -1,11 +1,12 @@
 #pragma once
-#include <SDL_mixer.h>
+#include "Adpcm.h"
+#include <memory>
 
 struct GameSounds {
-    Mix_Chunk* jump = nullptr;
-    Mix_Chunk* hit = nullptr;
-    Mix_Chunk* loseLife = nullptr;
-    Mix_Chunk* gameOver = nullptr;
-    Mix_Chunk* kill[5];
-    Mix_Chunk* enemySpawn = nullptr;
+    std::shared_ptr<AdpcmSound> jump;
+    std::shared_ptr<AdpcmSound> hit;
+    std::shared_ptr<AdpcmSound> loseLife;
+    std::shared_ptr<AdpcmSound> gameOver;
+    std::shared_ptr<AdpcmSound> kill[5];
+    std::shared_ptr<AdpcmSound> enemySpawn;
 };
@@ -1,15 +1,10 @@
 #pragma once
 #include <SDL.h>
+#include <memory>
 
+// Screen art is only held while its screen is up so the resource manager
+// can evict it; everything drawn during play lives in the sprite atlas.
 struct GameTextures {
-    SDL_Texture* background = nullptr;
-    SDL_Texture* ninja = nullptr;
-    SDL_Texture* shuriken = nullptr;
-    SDL_Texture* enemy = nullptr;
-    SDL_Texture* wall = nullptr;
-    SDL_Texture* platform = nullptr;
-    SDL_Texture* heart = nullptr;
-    SDL_Texture* menu = nullptr;
-    SDL_Texture* gameOver = nullptr;
-    SDL_Texture* pause = nullptr;
+    std::shared_ptr<SDL_Texture> menu;
+    std::shared_ptr<SDL_Texture> pause;
 };
@@ -0,0 +1,79 @@
+#include "ImageOps.h"
+
+SDL_Surface* resampleSurface(SDL_Surface* source, int width, int height) {
+    SDL_Surface* input = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!input) return nullptr;
+
+    SDL_Surface* output = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!output) {
+        SDL_FreeSurface(input);
+        return nullptr;
+    }
+
+    SDL_LockSurface(input);
+    SDL_LockSurface(output);
+
+    for (int dy = 0; dy < height; dy++) {
+        int sy0 = dy * input->h / height;
+        int sy1 = (dy + 1) * input->h / height;
+        if (sy1 <= sy0) sy1 = sy0 + 1;
+
+        Uint8* outRow = static_cast<Uint8*>(output->pixels) + dy * output->pitch;
+        for (int dx = 0; dx < width; dx++) {
+            int sx0 = dx * input->w / width;
+            int sx1 = (dx + 1) * input->w / width;
+            if (sx1 <= sx0) sx1 = sx0 + 1;
+
+            Uint64 red = 0, green = 0, blue = 0, alpha = 0;
+            for (int sy = sy0; sy < sy1; sy++) {
+                const Uint8* pixel = static_cast<const Uint8*>(input->pixels) + sy * input->pitch + sx0 * 4;
+                for (int sx = sx0; sx < sx1; sx++, pixel += 4) {
+                    red += pixel[0] * pixel[3];
+                    green += pixel[1] * pixel[3];
+                    blue += pixel[2] * pixel[3];
+                    alpha += pixel[3];
+                }
+            }
+
+            Uint8* out = outRow + dx * 4;
+            Uint64 samples = static_cast<Uint64>(sy1 - sy0) * (sx1 - sx0);
+            if (alpha > 0) {
+                out[0] = static_cast<Uint8>(red / alpha);
+                out[1] = static_cast<Uint8>(green / alpha);
+                out[2] = static_cast<Uint8>(blue / alpha);
+            } else {
+                out[0] = out[1] = out[2] = 0;
+            }
+            out[3] = static_cast<Uint8>(alpha / samples);
+        }
+    }
+
+    SDL_UnlockSurface(output);
+    SDL_UnlockSurface(input);
+    SDL_FreeSurface(input);
+    return output;
+}
+
+void premultiplyAlpha(SDL_Surface* surface) {
+    SDL_LockSurface(surface);
+    for (int y = 0; y < surface->h; y++) {
+        Uint8* pixel = static_cast<Uint8*>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < surface->w; x++, pixel += 4) {
+            pixel[0] = static_cast<Uint8>((pixel[0] * pixel[3] + 127) / 255);
+            pixel[1] = static_cast<Uint8>((pixel[1] * pixel[3] + 127) / 255);
+            pixel[2] = static_cast<Uint8>((pixel[2] * pixel[3] + 127) / 255);
+        }
+    }
+    SDL_UnlockSurface(surface);
+}
+
+SDL_Surface* premultipliedCopy(SDL_Surface* source, bool alreadyPremultiplied) {
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) return nullptr;
+    if (!alreadyPremultiplied) {
+        premultiplyAlpha(rgba);
+    }
+    SDL_Surface* copy = SDL_ConvertSurfaceFormat(rgba, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rgba);
+    return copy;
+}
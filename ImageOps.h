@@ -0,0 +1,13 @@
+#pragma once
+#include <SDL.h>
+
+// Returns a new RGBA32 surface of the given size. Downscaling averages every
+// source pixel under each destination pixel, weighting colour by alpha so
+// transparent edges don't darken; upscaling falls back to nearest neighbour.
+SDL_Surface* resampleSurface(SDL_Surface* source, int width, int height);
+
+// Multiplies colour by alpha in place. Expects an RGBA32 surface.
+void premultiplyAlpha(SDL_Surface* surface);
+
+// Returns a premultiplied ARGB8888 copy, the layout SoftwareRasterizer reads.
+SDL_Surface* premultipliedCopy(SDL_Surface* source, bool alreadyPremultiplied);
@@ -0,0 +1,214 @@
+#include "MusicStream.h"
+#include "ResourcePack.h"
+#include "constants.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const int READ_BYTES = 16 * 1024;
+// The ring holds BUFFER_COUNT * MUSIC_BUFFER_FRAMES, well over this.
+const Uint32 POLL_MS = 20;
+
+}
+
+MusicStream::~MusicStream() {
+    stop();
+}
+
+bool MusicStream::start(const ResourcePack& source, int outputFrequency, int outputChannels) {
+    if (thread) {
+        stop();
+    }
+
+    pack = &source;
+    frequency = outputFrequency;
+    channels = outputChannels;
+    bufferSamples = MUSIC_BUFFER_FRAMES * channels;
+    fadeFrames = std::max(1, frequency * MUSIC_FADE_MS / 1000);
+    buffers.assign(static_cast<size_t>(BUFFER_COUNT) * bufferSamples, 0);
+    currentSamples.assign(bufferSamples, 0);
+    fadingSamples.assign(bufferSamples, 0);
+    raw.assign(READ_BYTES, 0);
+    for (int i = 0; i < BUFFER_COUNT; i++) {
+        emptyBuffers.push(i);
+    }
+
+    SDL_AtomicSet(&requested, -1);
+    SDL_AtomicSet(&quit, 0);
+    wake = SDL_CreateSemaphore(0);
+    thread = wake ? SDL_CreateThread(threadMain, "music", this) : nullptr;
+    if (!thread) {
+        std::cerr << "Failed to start music thread: " << SDL_GetError() << std::endl;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void MusicStream::stop() {
+    if (thread) {
+        SDL_AtomicSet(&quit, 1);
+        SDL_SemPost(wake);
+        SDL_WaitThread(thread, nullptr);
+        thread = nullptr;
+    }
+    if (wake) {
+        SDL_DestroySemaphore(wake);
+        wake = nullptr;
+    }
+
+    closeTrack(current);
+    closeTrack(fading);
+    int index;
+    while (filledBuffers.pop(index)) {}
+    while (emptyBuffers.pop(index)) {}
+    playing = -1;
+    playPosition = 0;
+}
+
+void MusicStream::play(MusicId music) {
+    if (!thread) return;
+    if (SDL_AtomicSet(&requested, music) != music) {
+        SDL_SemPost(wake);
+    }
+}
+
+void MusicStream::mix(Sint32* out, int sampleCount) {
+    int mixed = 0;
+    while (mixed < sampleCount) {
+        if (playing < 0 && !filledBuffers.pop(playing)) return;
+
+        int count = std::min(bufferSamples - playPosition, sampleCount - mixed);
+        const Sint16* source = &buffers[static_cast<size_t>(playing) * bufferSamples + playPosition];
+        for (int i = 0; i < count; i++) {
+            out[mixed + i] += source[i];
+        }
+        mixed += count;
+        playPosition += count;
+
+        if (playPosition == bufferSamples) {
+            emptyBuffers.push(playing);
+            playing = -1;
+            playPosition = 0;
+        }
+    }
+}
+
+int MusicStream::threadMain(void* data) {
+    static_cast<MusicStream*>(data)->run();
+    return 0;
+}
+
+void MusicStream::run() {
+    while (!SDL_AtomicGet(&quit)) {
+        int music = SDL_AtomicGet(&requested);
+        if (music != current.music) {
+            // A switch during a fade cuts the older, already quieter track.
+            closeTrack(fading);
+            fading = current;
+            current = Track();
+            openTrack(current, music);
+            fadePosition = 0;
+        }
+
+        int index;
+        while ((current.stream || fading.stream) && emptyBuffers.pop(index)) {
+            fillBuffer(&buffers[static_cast<size_t>(index) * bufferSamples]);
+            filledBuffers.push(index);
+        }
+
+        SDL_SemWaitTimeout(wake, POLL_MS);
+    }
+}
+
+bool MusicStream::openTrack(Track& track, int music) {
+    track.music = music;
+    if (music < 0 || missing[music]) return false;
+
+    const char* file = musicFile(static_cast<MusicId>(music));
+    // Tracks are optional: a missing one leaves that screen silent.
+    SDL_RWops* source = pack->openAsset(file);
+    if (!source) {
+        missing[music] = true;
+        return false;
+    }
+
+    WavInfo info;
+    SDL_AudioStream* stream = nullptr;
+    if (readWavHeader(source, info)) {
+        stream = SDL_NewAudioStream(info.format, static_cast<Uint8>(info.channels), info.rate,
+                                    AUDIO_S16SYS, static_cast<Uint8>(channels), frequency);
+    }
+    if (!stream) {
+        std::cerr << "Failed to stream music: " << file << " - " << SDL_GetError() << std::endl;
+        SDL_RWclose(source);
+        missing[music] = true;
+        return false;
+    }
+
+    track.file = source;
+    track.stream = stream;
+    track.frameBytes = info.channels * (SDL_AUDIO_BITSIZE(info.format) / 8);
+    track.dataOffset = info.dataOffset;
+    track.dataSize = info.dataSize - info.dataSize % track.frameBytes;
+    track.dataLeft = track.dataSize;
+    return true;
+}
+
+void MusicStream::closeTrack(Track& track) {
+    if (track.stream) {
+        SDL_FreeAudioStream(track.stream);
+    }
+    if (track.file) {
+        SDL_RWclose(track.file);
+    }
+    track = Track();
+}
+
+int MusicStream::readTrack(Track& track, Sint16* out, int sampleCount) {
+    int bytes = sampleCount * static_cast<int>(sizeof(Sint16));
+    bool rewound = false;
+    while (SDL_AudioStreamAvailable(track.stream) < bytes) {
+        if (track.dataLeft == 0) {
+            // Loop back to the first sample; the converter carries on across the seam.
+            if (rewound || track.dataSize == 0 || SDL_RWseek(track.file, track.dataOffset, RW_SEEK_SET) < 0) break;
+            track.dataLeft = track.dataSize;
+            rewound = true;
+        }
+
+        size_t wanted = std::min<size_t>(raw.size() - raw.size() % track.frameBytes, track.dataLeft);
+        size_t read = SDL_RWread(track.file, raw.data(), 1, wanted);
+        read -= read % track.frameBytes;
+        if (read == 0) {
+            track.dataLeft = 0;
+            continue;
+        }
+        track.dataLeft -= static_cast<Uint32>(read);
+        rewound = false;
+        if (SDL_AudioStreamPut(track.stream, raw.data(), static_cast<int>(read)) < 0) break;
+    }
+
+    int got = SDL_AudioStreamGet(track.stream, out, bytes);
+    return got > 0 ? got / static_cast<int>(sizeof(Sint16)) : 0;
+}
+
+void MusicStream::fillBuffer(Sint16* out) {
+    int currentCount = current.stream ? readTrack(current, currentSamples.data(), bufferSamples) : 0;
+    std::fill(currentSamples.begin() + currentCount, currentSamples.end(), 0);
+    int fadingCount = fading.stream ? readTrack(fading, fadingSamples.data(), bufferSamples) : 0;
+    std::fill(fadingSamples.begin() + fadingCount, fadingSamples.end(), 0);
+
+    for (int i = 0; i < bufferSamples; i++) {
+        float in = fading.stream ? std::min(1.0f, static_cast<float>(fadePosition + i / channels) / fadeFrames) : 1.0f;
+        float mixed = currentSamples[i] * in + fadingSamples[i] * (1.0f - in);
+        out[i] = static_cast<Sint16>(mixed * MUSIC_VOLUME);
+    }
+
+    if (fading.stream) {
+        fadePosition += MUSIC_BUFFER_FRAMES;
+        if (fadePosition >= fadeFrames) {
+            closeTrack(fading);
+        }
+    }
+}
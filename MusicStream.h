@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "Assets.h"
+#include "SpscQueue.h"
+
+class ResourcePack;
+
+// Streams one looping track per game state from the resource pack or loose
+// files. A background thread reads and converts the WAV a block at a time into
+// a small ring of buffers that the audio callback drains, so memory use is the
+// ring however long the track is. Changing track crossfades: the thread keeps
+// reading the old track and mixes it out over MUSIC_FADE_MS.
+class MusicStream {
+public:
+    MusicStream() = default;
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+    ~MusicStream();
+
+    // Produces 16-bit samples in the device layout.
+    bool start(const ResourcePack& pack, int frequency, int channels);
+    // Only once the audio callback no longer mixes this stream.
+    void stop();
+
+    // Game thread; only wakes the stream thread when the track changes.
+    void play(MusicId music);
+
+    // Audio callback only. Adds the next samples; a drained ring adds nothing.
+    void mix(Sint32* out, int sampleCount);
+
+private:
+    static const int BUFFER_COUNT = 4;
+
+    struct Track {
+        SDL_RWops* file = nullptr;
+        SDL_AudioStream* stream = nullptr;
+        Sint64 dataOffset = 0;
+        Uint32 dataSize = 0;
+        Uint32 dataLeft = 0;
+        int frameBytes = 0;
+        int music = -1;
+    };
+
+    static int threadMain(void* data);
+    void run();
+    bool openTrack(Track& track, int music);
+    void closeTrack(Track& track);
+    int readTrack(Track& track, Sint16* out, int sampleCount);
+    void fillBuffer(Sint16* out);
+
+    const ResourcePack* pack = nullptr;
+    int frequency = 0;
+    int channels = 0;
+    int bufferSamples = 0;
+    int fadeFrames = 0;
+    std::vector<Sint16> buffers;
+    SpscQueue<int, BUFFER_COUNT> filledBuffers;
+    SpscQueue<int, BUFFER_COUNT> emptyBuffers;
+    SDL_atomic_t requested = {};
+    SDL_atomic_t quit = {};
+    SDL_sem* wake = nullptr;
+    SDL_Thread* thread = nullptr;
+
+    // Stream thread only.
+    Track current;
+    Track fading;
+    int fadePosition = 0;
+    bool missing[MUSIC_COUNT] = {};
+    std::vector<Uint8> raw;
+    std::vector<Sint16> currentSamples;
+    std::vector<Sint16> fadingSamples;
+
+    // Audio thread only.
+    int playing = -1;
+    int playPosition = 0;
+};
@@ -1,16 +1,33 @@
 #include "Platform.h"
 #include "constants.h"
 
-Platform::Platform(int x, int y) : alpha(255.0f) {
-    rect = { x, y, PLATFORM_WIDTH, PLATFORM_HEIGHT };
+void Platform::spawn(EntityRing& platforms, int x, int y) {
+    platforms.push(x, y, x < SCREEN_WIDTH / 2 ? LANE_LEFT : LANE_RIGHT);
 }
 
-void Platform::update(float speed) {
-    rect.y += static_cast<int>(speed);
-    if (alpha > 0) alpha -= 1.5f;
+void Platform::update(EntityRing& platforms, float speed) {
+    const int step = static_cast<int>(speed);
+    int* y = platforms.y.data();
+    int* prevY = platforms.prevY.data();
+    float* alpha = platforms.alpha.data();
+
+    platforms.forEachSegment([=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            prevY[i] = y[i];
+            y[i] += step;
+        }
+
+        for (size_t i = begin; i < end; i++) {
+            alpha[i] = alpha[i] > 0 ? alpha[i] - 1.5f : alpha[i];
+        }
+    });
 }
 
-void Platform::render(SDL_Renderer* renderer, SDL_Texture* texture) {
-    SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha));
-    SDL_RenderCopy(renderer, texture, nullptr, &rect);
+void Platform::render(const EntityRing& platforms, SpriteBatch& batch, float interpolation) {
+    for (size_t i = 0; i < platforms.size(); i++) {
+        size_t s = platforms.slot(i);
+        SDL_Rect destRect = platforms.rect(s);
+        destRect.y = platforms.prevY[s] + static_cast<int>((platforms.y[s] - platforms.prevY[s]) * interpolation);
+        batch.draw(SPRITE_PLATFORM, destRect, static_cast<Uint8>(platforms.alpha[s]));
+    }
 }
@@ -1,14 +1,13 @@
 #pragma once
 #include <SDL.h>
 #include "constants.h"
+#include "EntityStore.h"
+#include "SpriteBatch.h"
 
 using namespace std;
 
 struct Platform {
-    SDL_Rect rect;
-    float alpha;
-
-    Platform(int x, int y);
-    void update(float speed);
-    void render(SDL_Renderer* renderer, SDL_Texture* texture);
+    static void spawn(EntityRing& platforms, int x, int y);
+    static void update(EntityRing& platforms, float speed);
+    static void render(const EntityRing& platforms, SpriteBatch& batch, float interpolation);
 };
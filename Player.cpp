@@ -3,32 +3,35 @@
 
 Player::Player() : x(WALL_WIDTH), y(SCREEN_HEIGHT - 100 - PLAYER_HEIGHT), velocityY(0),
                   onLeftWall(true), isJumping(false), isAttached(true), score(0),
-                  scoreMultiplier(1.0f), lives(5), isInvincible(false) {
+                  scoreMultiplier(1.0f), lives(5), isInvincible(false),
+                  shurikens(SHURIKEN_WIDTH, SHURIKEN_HEIGHT, MAX_SHURIKENS), invincibleTime(0) {
     targetY = y;
-    lastMultiplierIncreaseTime = SDL_GetTicks();
-    lastScoreUpdateTime = SDL_GetTicks();
+    prevY = y;
+    lastMultiplierIncreaseTime = 0;
+    lastScoreUpdateTime = 0;
 }
 
-void Player::jump(GameSounds& sounds) {
-    if (isAttached) {
-        isAttached = false;
-        onLeftWall = !onLeftWall;
-        velocityY = JUMP_FORCE;
-        isJumping = true;
-        targetY = y;
-        Mix_PlayChannel(-1, sounds.jump, 0);
-    }
+bool Player::jump() {
+    if (!isAttached) return false;
+
+    isAttached = false;
+    onLeftWall = !onLeftWall;
+    velocityY = JUMP_FORCE;
+    isJumping = true;
+    targetY = y;
+    return true;
 }
 
 void Player::throwShuriken() {
-    if (isAttached && shurikens.size() < MAX_SHURIKENS) {
+    if (isAttached && !shurikens.full()) {
         int centerX = x + PLAYER_WIDTH/2;
         int centerY = y + PLAYER_HEIGHT/2;
-        shurikens.emplace_back(centerX, centerY);
+        Shuriken::spawn(shurikens, centerX, centerY);
     }
 }
 
-void Player::update() {
+void Player::update(Uint32 now) {
+    prevY = y;
     if (!isAttached) {
         velocityY += GRAVITY;
         y += velocityY;
@@ -43,28 +46,28 @@ void Player::update() {
     }
 
     if (y > SCREEN_HEIGHT) {
-        reset();
+        reset(now);
     }
 
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastMultiplierIncreaseTime > MULTIPLIER_INCREASE_INTERVAL) {
+    if (now - lastMultiplierIncreaseTime > MULTIPLIER_INCREASE_INTERVAL) {
         scoreMultiplier += 0.5f;
-        lastMultiplierIncreaseTime = currentTime;
+        lastMultiplierIncreaseTime = now;
     }
 
-    if (isInvincible && currentTime > invincibleTime) {
+    if (isInvincible && now > invincibleTime) {
         isInvincible = false;
     }
 
-    if (currentTime - lastScoreUpdateTime >= SCORE_UPDATE_INTERVAL) {
+    if (now - lastScoreUpdateTime >= SCORE_UPDATE_INTERVAL) {
         score += static_cast<int>(scoreMultiplier);
-        lastScoreUpdateTime = currentTime;
+        lastScoreUpdateTime = now;
     }
 }
 
-void Player::reset() {
+void Player::reset(Uint32 now) {
     y = SCREEN_HEIGHT - 100 - PLAYER_HEIGHT;
     targetY = y;
+    prevY = y;
     x = WALL_WIDTH;
     velocityY = 0;
     onLeftWall = true;
@@ -72,27 +75,28 @@ void Player::reset() {
     isAttached = true;
     score = 0;
     scoreMultiplier = 1.0f;
-    lastMultiplierIncreaseTime = SDL_GetTicks();
+    lastMultiplierIncreaseTime = now;
     lives = 5;
     isInvincible = false;
-    lastScoreUpdateTime = SDL_GetTicks();
+    lastScoreUpdateTime = now;
 }
 
-void Player::resetPosition() {
+void Player::resetPosition(Uint32 now) {
     y = SCREEN_HEIGHT - 100 - PLAYER_HEIGHT;
     targetY = y;
+    prevY = y;
     x = onLeftWall ? WALL_WIDTH : SCREEN_WIDTH - WALL_WIDTH - PLAYER_WIDTH;
     velocityY = 0;
     isAttached = true;
     isJumping = false;
     isInvincible = true;
-    invincibleTime = SDL_GetTicks() + PLAYER_INVINCIBLE_TIME;
+    invincibleTime = now + PLAYER_INVINCIBLE_TIME;
 }
 
-void Player::render(SDL_Renderer* renderer, SDL_Texture* texture) {
-    SDL_Rect destRect = { x, y, PLAYER_WIDTH, PLAYER_HEIGHT };
-    SDL_RendererFlip flip = onLeftWall ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
-    SDL_RenderCopyEx(renderer, texture, nullptr, &destRect, 0, nullptr, flip);
+void Player::render(SpriteBatch& batch, float interpolation) {
+    int drawY = prevY + static_cast<int>((y - prevY) * interpolation);
+    SDL_Rect destRect = { x, drawY, PLAYER_WIDTH, PLAYER_HEIGHT };
+    batch.draw(SPRITE_NINJA, destRect, 255, !onLeftWall);
 }
 
 SDL_Rect Player::getRect() const {
@@ -1,14 +1,15 @@
 #pragma once
 #include <SDL.h>
-#include "GameSounds.h"
 #include <string>
 #include "constants.h"
 #include <vector>
 #include "shuriken.h"
+#include "SpriteBatch.h"
 
 class Player {
 public:
     int x, y;
+    int prevY;
     float velocityY;
     bool onLeftWall;
     bool isJumping;
@@ -17,17 +18,17 @@ public:
     float scoreMultiplier;
     int lives;
     bool isInvincible;
-    std::vector<Shuriken> shurikens;
+    EntityStore shurikens;
     static const int MAX_SHURIKENS = 7;
     Uint32 invincibleTime;
 
     Player();
-    void jump(GameSounds& sounds);
+    bool jump();
     void throwShuriken();
-    void update();
-    void reset();
-    void resetPosition();
-    void render(SDL_Renderer* renderer, SDL_Texture* texture);
+    void update(Uint32 now);
+    void reset(Uint32 now);
+    void resetPosition(Uint32 now);
+    void render(SpriteBatch& batch, float interpolation);
     SDL_Rect getRect() const;
 
 private:
@@ -0,0 +1,27 @@
+#include "Random.h"
+
+Random::Random(Uint64 seedValue, Uint64 stream) {
+    seed(seedValue, stream);
+}
+
+void Random::seed(Uint64 seedValue, Uint64 stream) {
+    state = 0;
+    increment = (stream << 1) | 1;
+    next();
+    state += seedValue;
+    next();
+}
+
+void RandomStreams::seed(Uint64 runSeed) {
+    platforms.seed(mixSeed(runSeed + 1), 1);
+    enemies.seed(mixSeed(runSeed + 2), 2);
+    effects.seed(mixSeed(runSeed + 3), 3);
+}
+
+// SplitMix64 finaliser, used to spread nearby seeds across the state space.
+Uint64 mixSeed(Uint64 value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
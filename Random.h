@@ -0,0 +1,50 @@
+#pragma once
+#include <SDL.h>
+
+// PCG32 (XSH-RR): 64-bit state, selectable stream, 32-bit output.
+class Random {
+public:
+    Random(Uint64 seed = 0, Uint64 stream = 0);
+    void seed(Uint64 seed, Uint64 stream);
+
+    Uint32 next() {
+        Uint64 old = state;
+        state = old * 6364136223846793005ULL + increment;
+        Uint32 xorshifted = static_cast<Uint32>(((old >> 18) ^ old) >> 27);
+        Uint32 rot = static_cast<Uint32>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    // Unbiased value in [0, bound) using a multiply-shift, with rejection
+    // only in the rare biased band.
+    Uint32 below(Uint32 bound) {
+        Uint64 product = static_cast<Uint64>(next()) * bound;
+        Uint32 low = static_cast<Uint32>(product);
+        if (low < bound) {
+            Uint32 threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<Uint64>(next()) * bound;
+                low = static_cast<Uint32>(product);
+            }
+        }
+        return static_cast<Uint32>(product >> 32);
+    }
+
+    bool chance() { return (next() & 0x80000000u) != 0; }
+
+private:
+    Uint64 state;
+    Uint64 increment;
+};
+
+// Independent streams for each consumer, all derived from one per-run seed so
+// that changing how often one system draws never shifts another's sequence.
+struct RandomStreams {
+    Random platforms;
+    Random enemies;
+    Random effects;
+
+    void seed(Uint64 runSeed);
+};
+
+Uint64 mixSeed(Uint64 value);
@@ -0,0 +1,108 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char REPLAY_MAGIC[4] = { 'N', 'J', 'R', 'P' };
+const Uint8 REPLAY_VERSION = 2;
+
+void putVarint(std::vector<Uint8>& out, Uint64 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<Uint8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<Uint8>(value));
+}
+
+bool getVarint(const std::vector<Uint8>& in, size_t& pos, Uint64& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        Uint8 byte = in[pos++];
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+}
+
+void Replay::clear() {
+    seed = 0;
+    tickCount = 0;
+    events.clear();
+    checkpoints.clear();
+}
+
+bool Replay::save(const std::string& path) const {
+    std::vector<Uint8> data(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    data.push_back(REPLAY_VERSION);
+    putVarint(data, seed);
+    putVarint(data, tickCount);
+
+    // Events are delta-coded against the previous tick with the key in the low bits.
+    putVarint(data, events.size());
+    Uint32 lastTick = 0;
+    for (const auto& event : events) {
+        putVarint(data, (static_cast<Uint64>(event.tick - lastTick) << 2) | static_cast<Uint8>(event.key));
+        lastTick = event.tick;
+    }
+
+    putVarint(data, checkpoints.size());
+    for (Uint32 hash : checkpoints) {
+        for (int i = 0; i < 4; i++) {
+            data.push_back(static_cast<Uint8>(hash >> (i * 8)));
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const std::string& path) {
+    clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::vector<Uint8> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < 5 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, data.begin()) || data[4] != REPLAY_VERSION) {
+        return false;
+    }
+
+    size_t pos = 5;
+    Uint64 value = 0;
+    if (!getVarint(data, pos, seed)) return false;
+    if (!getVarint(data, pos, value)) return false;
+    tickCount = static_cast<Uint32>(value);
+
+    Uint64 eventCount = 0;
+    if (!getVarint(data, pos, eventCount)) return false;
+    Uint32 tick = 0;
+    for (Uint64 i = 0; i < eventCount; i++) {
+        if (!getVarint(data, pos, value)) return false;
+        tick += static_cast<Uint32>(value >> 2);
+        events.push_back({ tick, static_cast<InputKey>(value & 3) });
+    }
+
+    Uint64 checkpointCount = 0;
+    if (!getVarint(data, pos, checkpointCount) || data.size() - pos < checkpointCount * 4) return false;
+    for (Uint64 i = 0; i < checkpointCount; i++, pos += 4) {
+        checkpoints.push_back(data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) | (static_cast<Uint32>(data[pos + 3]) << 24));
+    }
+
+    return true;
+}
+
+// FNV-1a, chained by passing the previous hash back in.
+Uint32 hashBytes(Uint32 hash, const void* data, size_t size) {
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
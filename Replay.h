@@ -0,0 +1,28 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+enum class InputKey : Uint8 { SPACE, S, ESCAPE, R };
+
+struct ReplayEvent {
+    Uint32 tick;
+    InputKey key;
+};
+
+// One recorded session: the seed it started from, every gameplay input
+// stamped with the simulation tick it was applied before, and a chained
+// state hash sampled every REPLAY_CHECKPOINT_INTERVAL ticks.
+class Replay {
+public:
+    Uint64 seed = 0;
+    Uint32 tickCount = 0;
+    std::vector<ReplayEvent> events;
+    std::vector<Uint32> checkpoints;
+
+    void clear();
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+Uint32 hashBytes(Uint32 hash, const void* data, size_t size);
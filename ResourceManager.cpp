@@ -0,0 +1,153 @@
+#include "ResourceManager.h"
+#include "ResourcePack.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+size_t textureBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int width = 0;
+    int height = 0;
+    if (!texture || SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0) return 0;
+    return static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+}
+
+}
+
+void ResourceManager::init(SDL_Renderer* targetRenderer, const ResourcePack* resourcePack, Uint32 imageFormat,
+                           bool premultipliedAlpha) {
+    renderer = targetRenderer;
+    pack = resourcePack;
+    format = imageFormat;
+    premultiplied = premultipliedAlpha;
+}
+
+ResourceManager::Entry& ResourceManager::touch(const std::string& name) {
+    Entry& entry = entries[name];
+    entry.lastUse = ++useCounter;
+    return entry;
+}
+
+ResourceManager::Texture ResourceManager::texture(ImageId image, bool evictable) {
+    auto it = entries.find(imageAsset(image).file);
+    if (it != entries.end() && it->second.texture) {
+        it->second.lastUse = ++useCounter;
+        return it->second.texture;
+    }
+
+    SDL_Surface* surface = loadCookedImage(*pack, image, format, premultiplied);
+    if (!surface) {
+        surface = prepareImage(*pack, image, format, premultiplied);
+    }
+    Texture handle = createTexture(image, surface, evictable);
+    SDL_FreeSurface(surface);
+    return handle;
+}
+
+ResourceManager::Texture ResourceManager::addTexture(ImageId image, SDL_Surface* surface, bool evictable) {
+    auto it = entries.find(imageAsset(image).file);
+    if (it != entries.end() && it->second.texture) {
+        it->second.lastUse = ++useCounter;
+        return it->second.texture;
+    }
+    return createTexture(image, surface, evictable);
+}
+
+ResourceManager::Texture ResourceManager::createTexture(ImageId image, SDL_Surface* surface, bool evictable) {
+    if (!surface) return nullptr;
+
+    SDL_Texture* raw = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!raw) {
+        std::cerr << "Failed to create texture: " << imageAsset(image).file << " - " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(raw, premultiplied ? premultipliedBlendMode() : SDL_BLENDMODE_BLEND);
+
+    Entry& entry = touch(imageAsset(image).file);
+    entry.texture = Texture(raw, SDL_DestroyTexture);
+    entry.gpuBytes = textureBytes(raw);
+    entry.evictable = evictable;
+    return entry.texture;
+}
+
+ResourceManager::Sound ResourceManager::addSound(SoundId sound, AdpcmSound* loaded) {
+    if (!loaded) return nullptr;
+
+    Entry& entry = touch(soundFile(sound));
+    if (entry.sound) {
+        delete loaded;
+        return entry.sound;
+    }
+    entry.sound = Sound(loaded);
+    entry.cpuBytes = sizeof(AdpcmSound) + loaded->data.size();
+    return entry.sound;
+}
+
+void ResourceManager::trackTexture(const std::string& name, SDL_Texture* texture) {
+    Entry& entry = touch(name);
+    entry.tracked = true;
+    entry.gpuBytes = textureBytes(texture);
+}
+
+size_t ResourceManager::totalBytes() const {
+    size_t total = 0;
+    for (const auto& item : entries) {
+        total += item.second.cpuBytes + item.second.gpuBytes;
+    }
+    return total;
+}
+
+void ResourceManager::trim() {
+    size_t total = totalBytes();
+    while (total > budget) {
+        // Only the cache's own reference left means nobody is drawing it.
+        auto victim = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            const Entry& entry = it->second;
+            bool unused = (entry.texture && entry.texture.use_count() == 1) || (entry.sound && entry.sound.use_count() == 1);
+            if (entry.evictable && unused && (victim == entries.end() || entry.lastUse < victim->second.lastUse)) {
+                victim = it;
+            }
+        }
+        if (victim == entries.end()) return;
+
+        total -= victim->second.cpuBytes + victim->second.gpuBytes;
+        entries.erase(victim);
+    }
+}
+
+void ResourceManager::clear() {
+    entries.clear();
+}
+
+void ResourceManager::report(std::ostream& out) const {
+    std::vector<std::pair<std::string, const Entry*>> ordered;
+    for (const auto& item : entries) {
+        ordered.push_back({ item.first, &item.second });
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    out << "Resources (KiB):" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    for (const auto& item : ordered) {
+        const Entry& entry = *item.second;
+        long handles = entry.texture ? entry.texture.use_count() - 1 : entry.sound ? entry.sound.use_count() - 1 : 0;
+        out << "  " << std::left << std::setw(20) << item.first << std::right
+            << " cpu " << std::setw(8) << entry.cpuBytes / 1024.0
+            << "  gpu " << std::setw(8) << entry.gpuBytes / 1024.0
+            << (entry.tracked ? "  external" : entry.evictable ? "  evictable" : "  pinned");
+        if (!entry.tracked) out << ", " << handles << " handles";
+        out << std::endl;
+    }
+    out << "  total " << totalBytes() / 1024.0 << " of ";
+    if (budget == SIZE_MAX) {
+        out << "unlimited";
+    } else {
+        out << budget / 1024.0;
+    }
+    out << " budget" << std::endl;
+    out << std::defaultfloat;
+}
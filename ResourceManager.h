@@ -0,0 +1,61 @@
+#pragma once
+#include <SDL.h>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include "Adpcm.h"
+#include "Assets.h"
+
+class ResourcePack;
+
+// Owns every texture and sound, keyed by asset path, and hands out shared
+// handles: asking twice for the same path returns the same object. Entries
+// stay cached after their last handle is dropped; evictable ones are freed,
+// least recently acquired first, once the total goes over the budget, and
+// are reloaded on the next request.
+class ResourceManager {
+public:
+    using Texture = std::shared_ptr<SDL_Texture>;
+    using Sound = std::shared_ptr<AdpcmSound>;
+
+    void init(SDL_Renderer* renderer, const ResourcePack* pack, Uint32 imageFormat, bool premultipliedAlpha);
+    void setBudget(size_t bytes) { budget = bytes; }
+
+    // Loads synchronously on a miss.
+    Texture texture(ImageId image, bool evictable);
+    // Adopts a surface decoded elsewhere; the surface itself stays with the caller.
+    Texture addTexture(ImageId image, SDL_Surface* surface, bool evictable);
+    // Adopts a loaded sound and takes ownership of it.
+    Sound addSound(SoundId sound, AdpcmSound* loaded);
+    // Accounts for a texture owned elsewhere (atlases) without managing it.
+    void trackTexture(const std::string& name, SDL_Texture* texture);
+
+    void trim();
+    void clear();
+    size_t totalBytes() const;
+    void report(std::ostream& out) const;
+
+private:
+    struct Entry {
+        Texture texture;
+        Sound sound;
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        bool evictable = false;
+        bool tracked = false;
+        Uint64 lastUse = 0;
+    };
+
+    Entry& touch(const std::string& name);
+    Texture createTexture(ImageId image, SDL_Surface* surface, bool evictable);
+
+    SDL_Renderer* renderer = nullptr;
+    const ResourcePack* pack = nullptr;
+    Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+    bool premultiplied = false;
+    size_t budget = SIZE_MAX;
+    Uint64 useCounter = 0;
+    std::unordered_map<std::string, Entry> entries;
+};
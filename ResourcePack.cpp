@@ -0,0 +1,198 @@
+#include "ResourcePack.h"
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char PACK_MAGIC[4] = { 'N', 'J', 'P', 'K' };
+const Uint32 PACK_VERSION = 1;
+const size_t PACK_ALIGNMENT = 16;
+
+void putUint(std::vector<Uint8>& out, Uint64 value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.push_back(static_cast<Uint8>(value >> (i * 8)));
+    }
+}
+
+bool getUint(const Uint8* data, size_t size, size_t& pos, int bytes, Uint64& value) {
+    if (size - pos < static_cast<size_t>(bytes)) return false;
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<Uint64>(data[pos++]) << (i * 8);
+    }
+    return true;
+}
+
+}
+
+ResourcePack::~ResourcePack() {
+    close();
+}
+
+bool ResourcePack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    HANDLE view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (!view) {
+        CloseHandle(file);
+        return false;
+    }
+    mapping = static_cast<const Uint8*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+    if (!mapping) {
+        CloseHandle(view);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = view;
+    mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+    if (view == MAP_FAILED) return false;
+    mapping = static_cast<const Uint8*>(view);
+    mappingSize = static_cast<size_t>(info.st_size);
+#endif
+
+    // Header: magic, version, entry count; then per entry offset, size, hash
+    // and a length-prefixed name, sorted by name. Data follows the index.
+    size_t pos = 0;
+    Uint64 version = 0;
+    Uint64 count = 0;
+    bool valid = mappingSize >= 4 && std::equal(PACK_MAGIC, PACK_MAGIC + 4, mapping);
+    pos = 4;
+    valid = valid && getUint(mapping, mappingSize, pos, 4, version) && version == PACK_VERSION &&
+            getUint(mapping, mappingSize, pos, 4, count);
+
+    for (Uint64 i = 0; valid && i < count; i++) {
+        Uint64 offset = 0, size = 0, hash = 0, nameLength = 0;
+        valid = getUint(mapping, mappingSize, pos, 8, offset) && getUint(mapping, mappingSize, pos, 8, size) &&
+                getUint(mapping, mappingSize, pos, 4, hash) && getUint(mapping, mappingSize, pos, 2, nameLength) &&
+                mappingSize - pos >= nameLength && offset <= mappingSize && size <= mappingSize - offset;
+        if (valid) {
+            entries.push_back({ std::string(reinterpret_cast<const char*>(mapping + pos), nameLength),
+                                mapping + offset, size, static_cast<Uint32>(hash) });
+            pos += nameLength;
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Ignoring malformed resource pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ResourcePack::close() {
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<Uint8*>(mapping), mappingSize);
+#endif
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    entries.clear();
+}
+
+const ResourcePack::Entry* ResourcePack::find(const std::string& name) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), name,
+                               [](const Entry& entry, const std::string& key) { return entry.name < key; });
+    return it != entries.end() && it->name == name ? &*it : nullptr;
+}
+
+bool ResourcePack::contains(const std::string& name) const {
+    return find(name) != nullptr;
+}
+
+SDL_RWops* ResourcePack::openAsset(const std::string& name) const {
+    if (const Entry* entry = find(name)) {
+        return SDL_RWFromConstMem(entry->data, static_cast<int>(entry->size));
+    }
+    return SDL_RWFromFile(name.c_str(), "rb");
+}
+
+bool ResourcePack::verify() const {
+    for (const auto& entry : entries) {
+        if (hashBytes(2166136261u, entry.data, entry.size) != entry.hash) {
+            std::cerr << "Resource pack entry is corrupt: " << entry.name << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResourcePack::write(const std::string& path, const std::vector<std::string>& files) {
+    std::vector<std::string> names(files);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    std::vector<std::vector<Uint8>> contents;
+    size_t indexSize = 4 + 4 + 4;
+    for (const auto& name : names) {
+        std::ifstream file(name, std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to read " << name << std::endl;
+            return false;
+        }
+        contents.emplace_back((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        indexSize += 8 + 8 + 4 + 2 + name.size();
+    }
+
+    std::vector<Uint8> data(PACK_MAGIC, PACK_MAGIC + 4);
+    putUint(data, PACK_VERSION, 4);
+    putUint(data, names.size(), 4);
+
+    // Aligned offsets keep every entry safe to read in place as pixels or samples.
+    size_t offset = indexSize;
+    for (size_t i = 0; i < names.size(); i++) {
+        offset = (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+        putUint(data, offset, 8);
+        putUint(data, contents[i].size(), 8);
+        putUint(data, hashBytes(2166136261u, contents[i].data(), contents[i].size()), 4);
+        putUint(data, names[i].size(), 2);
+        data.insert(data.end(), names[i].begin(), names[i].end());
+        offset += contents[i].size();
+    }
+
+    for (const auto& content : contents) {
+        data.resize((data.size() + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1), 0);
+        data.insert(data.end(), content.begin(), content.end());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+// One read-only archive mapped into memory at startup. Entries are served as
+// SDL_RWops over the mapping, so decoders read straight from the page cache.
+// Names not in the pack, or every name when no pack is open, fall through to
+// loose files on disk.
+class ResourcePack {
+public:
+    ResourcePack() = default;
+    ResourcePack(const ResourcePack&) = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+    ~ResourcePack();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    bool contains(const std::string& name) const;
+    SDL_RWops* openAsset(const std::string& name) const;
+    // Re-hashes every entry; the game trusts the pack, the builder checks it.
+    bool verify() const;
+
+    static bool write(const std::string& path, const std::vector<std::string>& files);
+
+private:
+    struct Entry {
+        std::string name;
+        const Uint8* data;
+        Uint64 size;
+        Uint32 hash;
+    };
+
+    const Entry* find(const std::string& name) const;
+
+    const Uint8* mapping = nullptr;
+    size_t mappingSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    std::vector<Entry> entries;
+};
@@ -0,0 +1,329 @@
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NINJUMP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if NINJUMP_SSE2 && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NINJUMP_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const int TILE_HEIGHT = 32;
+const int MAX_THREADS = 8;
+const Uint32 NO_TINT = 0xFFFFFFFF;
+
+typedef void (*BlendFn)(Uint32* dst, const Uint32* src, int count, Uint32 tint);
+
+// x * y / 255, rounded; exact for 8-bit inputs.
+inline Uint32 mul8(Uint32 x, Uint32 y) {
+    Uint32 t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Source-over for premultiplied pixels: dst = src * tint + dst * (1 - srcAlpha).
+void blendSpanScalar(Uint32* dst, const Uint32* src, int count, Uint32 tint) {
+    for (int i = 0; i < count; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        Uint32 sa = mul8(s >> 24, tint >> 24);
+        Uint32 inverse = 255 - sa;
+        Uint32 out = (sa + mul8(d >> 24, inverse)) << 24;
+        for (int shift = 0; shift < 24; shift += 8) {
+            Uint32 channel = mul8((s >> shift) & 0xFF, (tint >> shift) & 0xFF);
+            out |= (channel + mul8((d >> shift) & 0xFF, inverse)) << shift;
+        }
+        dst[i] = out;
+    }
+}
+
+#if NINJUMP_SSE2
+inline __m128i mul8Sse2(__m128i x, __m128i y) {
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline __m128i blendHalfSse2(__m128i s, __m128i d, __m128i tint) {
+    s = mul8Sse2(s, tint);
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_add_epi16(s, mul8Sse2(d, _mm_sub_epi16(_mm_set1_epi16(255), alpha)));
+}
+
+void blendSpanSse2(Uint32* dst, const Uint32* src, int count, Uint32 tint) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i tint16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(tint)), zero);
+    const bool tinted = tint != NO_TINT;
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Four opaque, untinted pixels are a plain copy; most of a frame is.
+        if (!tinted && _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+            continue;
+        }
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i low = blendHalfSse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), tint16);
+        __m128i high = blendHalfSse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), tint16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+    }
+    blendSpanScalar(dst + i, src + i, count - i, tint);
+}
+#endif
+
+#if NINJUMP_AVX2
+__attribute__((target("avx2")))
+inline __m256i mul8Avx2(__m256i x, __m256i y) {
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+inline __m256i blendHalfAvx2(__m256i s, __m256i d, __m256i tint) {
+    s = mul8Avx2(s, tint);
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_epi16(s, mul8Avx2(d, _mm256_sub_epi16(_mm256_set1_epi16(255), alpha)));
+}
+
+__attribute__((target("avx2")))
+void blendSpanAvx2(Uint32* dst, const Uint32* src, int count, Uint32 tint) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    const __m256i tint16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(tint)), zero);
+    const bool tinted = tint != NO_TINT;
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        if (!tinted && _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alphaMask), alphaMask)) == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+            continue;
+        }
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        // unpack and pack both work within 128-bit lanes, so pixel order survives the round trip.
+        __m256i low = blendHalfAvx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), tint16);
+        __m256i high = blendHalfAvx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), tint16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(low, high));
+    }
+    blendSpanSse2(dst + i, src + i, count - i, tint);
+}
+#endif
+
+BlendFn selectBlend(const char** name) {
+#if NINJUMP_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return blendSpanAvx2;
+    }
+#endif
+#if NINJUMP_SSE2
+    *name = "sse2";
+    return blendSpanSse2;
+#else
+    *name = "scalar";
+    return blendSpanScalar;
+#endif
+}
+
+const char* blendName = nullptr;
+BlendFn blendSpan = selectBlend(&blendName);
+
+Uint32 packColor(SDL_Color color, bool premultiplied) {
+    Uint32 r = color.r, g = color.g, b = color.b;
+    if (!premultiplied) {
+        r = mul8(r, color.a);
+        g = mul8(g, color.a);
+        b = mul8(b, color.a);
+    }
+    return (static_cast<Uint32>(color.a) << 24) | (r << 16) | (g << 8) | b;
+}
+
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() {
+    destroy();
+}
+
+int SoftwareRasterizer::defaultThreadCount() {
+    return std::max(1, std::min(SDL_GetCPUCount(), MAX_THREADS));
+}
+
+const char* SoftwareRasterizer::blendBackend() {
+    return blendName;
+}
+
+bool SoftwareRasterizer::init(SDL_Renderer* targetRenderer, int frameWidth, int frameHeight, int threadCount) {
+    renderer = targetRenderer;
+    width = frameWidth;
+    height = frameHeight;
+    framebuffer.assign(static_cast<size_t>(width) * height, 0);
+    mainScratch.assign(width, 0);
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!texture) {
+        std::cerr << "Failed to create software framebuffer: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    workReady = SDL_CreateSemaphore(0);
+    workDone = SDL_CreateSemaphore(0);
+    quitting = false;
+    // The presenting thread rasterizes tiles too, so it counts as one of them.
+    workers.resize(std::max(0, threadCount - 1));
+    for (auto& worker : workers) {
+        worker.rasterizer = this;
+        worker.scratch.assign(width, 0);
+        worker.thread = nullptr;
+    }
+    for (auto& worker : workers) {
+        worker.thread = SDL_CreateThread(workerMain, "Rasterizer", &worker);
+        if (!worker.thread) {
+            std::cerr << "Failed to start rasterizer thread: " << SDL_GetError() << std::endl;
+        }
+    }
+    workers.erase(std::remove_if(workers.begin(), workers.end(), [](const Worker& worker) { return !worker.thread; }),
+                  workers.end());
+    return true;
+}
+
+void SoftwareRasterizer::destroy() {
+    quitting = true;
+    for (size_t i = 0; i < workers.size(); i++) {
+        SDL_SemPost(workReady);
+    }
+    for (auto& worker : workers) {
+        SDL_WaitThread(worker.thread, nullptr);
+    }
+    workers.clear();
+
+    SDL_DestroySemaphore(workReady);
+    SDL_DestroySemaphore(workDone);
+    workReady = nullptr;
+    workDone = nullptr;
+    SDL_DestroyTexture(texture);
+    texture = nullptr;
+    recording = false;
+}
+
+void SoftwareRasterizer::begin(Uint32 clearColor) {
+    clear = clearColor;
+    commands.clear();
+    recording = true;
+}
+
+void SoftwareRasterizer::drawQuads(const SDL_Surface* image, bool premultipliedColor, const SDL_Vertex* vertices,
+                                   const int* indices, int indexCount) {
+    for (int i = 0; i + 6 <= indexCount; i += 6) {
+        const SDL_Vertex& topLeft = vertices[indices[i]];
+        const SDL_Vertex& bottomRight = vertices[indices[i + 2]];
+
+        Command command;
+        command.image = image;
+        command.dest.x = static_cast<int>(std::lround(topLeft.position.x));
+        command.dest.y = static_cast<int>(std::lround(topLeft.position.y));
+        command.dest.w = static_cast<int>(std::lround(bottomRight.position.x)) - command.dest.x;
+        command.dest.h = static_cast<int>(std::lround(bottomRight.position.y)) - command.dest.y;
+        if (command.dest.w <= 0 || command.dest.h <= 0) continue;
+
+        // 16.16 source position of the first destination pixel centre and
+        // the step per pixel; a flipped quad simply steps backwards.
+        double left = topLeft.tex_coord.x * image->w * 65536.0;
+        double top = topLeft.tex_coord.y * image->h * 65536.0;
+        double right = bottomRight.tex_coord.x * image->w * 65536.0;
+        double bottom = bottomRight.tex_coord.y * image->h * 65536.0;
+        command.stepX = static_cast<Sint64>((right - left) / command.dest.w);
+        command.stepY = static_cast<Sint64>((bottom - top) / command.dest.h);
+        command.sourceX = static_cast<Sint64>(left) + command.stepX / 2;
+        command.sourceY = static_cast<Sint64>(top) + command.stepY / 2;
+        command.tint = packColor(topLeft.color, premultipliedColor);
+        commands.push_back(command);
+    }
+}
+
+void SoftwareRasterizer::present() {
+    recording = false;
+
+    SDL_AtomicSet(&nextTile, 0);
+    for (size_t i = 0; i < workers.size(); i++) {
+        SDL_SemPost(workReady);
+    }
+    rasterizeTiles(mainScratch);
+    for (size_t i = 0; i < workers.size(); i++) {
+        SDL_SemWait(workDone);
+    }
+
+    SDL_UpdateTexture(texture, nullptr, framebuffer.data(), width * static_cast<int>(sizeof(Uint32)));
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    commands.clear();
+}
+
+int SoftwareRasterizer::workerMain(void* data) {
+    Worker* worker = static_cast<Worker*>(data);
+    SoftwareRasterizer* rasterizer = worker->rasterizer;
+    for (;;) {
+        SDL_SemWait(rasterizer->workReady);
+        if (rasterizer->quitting) break;
+        rasterizer->rasterizeTiles(worker->scratch);
+        SDL_SemPost(rasterizer->workDone);
+    }
+    return 0;
+}
+
+void SoftwareRasterizer::rasterizeTiles(std::vector<Uint32>& scratch) {
+    const int tileCount = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+    for (int tile = SDL_AtomicAdd(&nextTile, 1); tile < tileCount; tile = SDL_AtomicAdd(&nextTile, 1)) {
+        rasterizeTile(tile * TILE_HEIGHT, std::min(height, (tile + 1) * TILE_HEIGHT), scratch);
+    }
+}
+
+void SoftwareRasterizer::rasterizeTile(int top, int bottom, std::vector<Uint32>& scratch) {
+    std::fill(framebuffer.begin() + static_cast<size_t>(top) * width,
+              framebuffer.begin() + static_cast<size_t>(bottom) * width, clear);
+
+    // Every tile walks the whole command list in order, so overlap resolves
+    // exactly as it would on the GPU.
+    for (const Command& command : commands) {
+        int x0 = std::max(command.dest.x, 0);
+        int x1 = std::min(command.dest.x + command.dest.w, width);
+        int y0 = std::max(command.dest.y, top);
+        int y1 = std::min(command.dest.y + command.dest.h, bottom);
+        if (x0 >= x1 || y0 >= y1) continue;
+
+        const SDL_Surface* image = command.image;
+        const int count = x1 - x0;
+        const Sint64 firstX = command.sourceX + (x0 - command.dest.x) * command.stepX;
+        const bool contiguous = command.stepX == 65536;
+
+        for (int y = y0; y < y1; y++) {
+            int sourceRow = static_cast<int>((command.sourceY + (y - command.dest.y) * command.stepY) >> 16);
+            sourceRow = std::min(std::max(sourceRow, 0), image->h - 1);
+            const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(image->pixels) +
+                                                                static_cast<size_t>(sourceRow) * image->pitch);
+
+            const Uint32* source;
+            int firstColumn = static_cast<int>(firstX >> 16);
+            if (contiguous && firstColumn >= 0 && firstColumn + count <= image->w) {
+                source = row + firstColumn;
+            } else {
+                // Scaled or flipped spans are gathered first so the blend stays one kernel.
+                Sint64 position = firstX;
+                for (int i = 0; i < count; i++, position += command.stepX) {
+                    int column = static_cast<int>(position >> 16);
+                    scratch[i] = row[std::min(std::max(column, 0), image->w - 1)];
+                }
+                source = scratch.data();
+            }
+
+            blendSpan(&framebuffer[static_cast<size_t>(y) * width + x0], source, count, command.tint);
+        }
+    }
+}
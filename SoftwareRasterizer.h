@@ -0,0 +1,67 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// CPU backend for the game's quad draw path, for machines where SDL would
+// otherwise fall back to its generic software renderer. SpriteBatch and
+// TextRenderer hand over their quads between begin() and present(); present()
+// rasterizes the frame in horizontal tiles on several threads with SIMD blend
+// kernels, then shows it with a single texture upload. Quads must be
+// axis-aligned and images premultiplied ARGB8888.
+class SoftwareRasterizer {
+public:
+    SoftwareRasterizer() = default;
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+    ~SoftwareRasterizer();
+
+    bool init(SDL_Renderer* renderer, int width, int height, int threadCount);
+    void destroy();
+
+    void begin(Uint32 clearColor);
+    bool active() const { return recording; }
+    // Colours are straight alpha unless premultipliedColor is set.
+    void drawQuads(const SDL_Surface* image, bool premultipliedColor, const SDL_Vertex* vertices,
+                   const int* indices, int indexCount);
+    void present();
+
+    static int defaultThreadCount();
+    static const char* blendBackend();
+
+private:
+    struct Command {
+        const SDL_Surface* image;
+        SDL_Rect dest;
+        Sint64 sourceX;
+        Sint64 sourceY;
+        Sint64 stepX;
+        Sint64 stepY;
+        Uint32 tint;
+    };
+
+    struct Worker {
+        SoftwareRasterizer* rasterizer;
+        SDL_Thread* thread;
+        std::vector<Uint32> scratch;
+    };
+
+    static int workerMain(void* data);
+    void rasterizeTiles(std::vector<Uint32>& scratch);
+    void rasterizeTile(int top, int bottom, std::vector<Uint32>& scratch);
+
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+    std::vector<Uint32> framebuffer;
+    std::vector<Uint32> mainScratch;
+    std::vector<Command> commands;
+    Uint32 clear = 0;
+    bool recording = false;
+
+    std::vector<Worker> workers;
+    SDL_sem* workReady = nullptr;
+    SDL_sem* workDone = nullptr;
+    SDL_atomic_t nextTile;
+    bool quitting = false;
+};
@@ -0,0 +1,131 @@
+#include "SpriteBatch.h"
+#include "Assets.h"
+#include "ImageOps.h"
+#include "SoftwareRasterizer.h"
+#include <iostream>
+
+namespace {
+
+const int ATLAS_PADDING = 1;
+const int ATLAS_MAX_WIDTH = 1024;
+const int RESERVED_QUADS = 128;
+
+}
+
+bool SpriteBatch::build(SDL_Renderer* targetRenderer, SDL_Surface* const sources[SPRITE_COUNT], bool premultipliedAlpha) {
+    renderer = targetRenderer;
+    premultiplied = premultipliedAlpha;
+
+    // Shelf-pack in declaration order, which lists the tall sprites first.
+    int atlasWidth = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    int penX = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        int width = sources[i]->w;
+        int height = sources[i]->h;
+        if (penX + width > ATLAS_MAX_WIDTH) {
+            penX = 0;
+            shelfY += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        cells[i] = { penX, shelfY, width, height };
+        penX += width + ATLAS_PADDING;
+        if (penX > atlasWidth) atlasWidth = penX;
+        if (height > shelfHeight) shelfHeight = height;
+    }
+    int atlasHeight = shelfY + shelfHeight;
+    texelWidth = 1.0f / atlasWidth;
+    texelHeight = 1.0f / atlasHeight;
+
+    // Sources arrive in the renderer's format, so the sheet uses it too and every blit is a row copy.
+    Uint32 format = sources[0]->format->format;
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, SDL_BITSPERPIXEL(format), format);
+    if (!sheet) {
+        std::cerr << "Failed to create sprite atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_FillRect(sheet, nullptr, 0);
+
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        SDL_SetSurfaceBlendMode(sources[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(sources[i], nullptr, sheet, &cells[i]);
+
+        uv[i] = { static_cast<float>(cells[i].x) / atlasWidth, static_cast<float>(cells[i].y) / atlasHeight,
+                  static_cast<float>(cells[i].w) / atlasWidth, static_cast<float>(cells[i].h) / atlasHeight };
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+    if (rasterizer) {
+        pixels = premultipliedCopy(sheet, premultiplied);
+    }
+    SDL_FreeSurface(sheet);
+    if (!atlas) {
+        std::cerr << "Failed to create sprite atlas texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, premultiplied ? premultipliedBlendMode() : SDL_BLENDMODE_BLEND);
+
+    vertices.reserve(RESERVED_QUADS * 4);
+    indices.reserve(RESERVED_QUADS * 6);
+    return true;
+}
+
+void SpriteBatch::destroy() {
+    SDL_DestroyTexture(atlas);
+    SDL_FreeSurface(pixels);
+    atlas = nullptr;
+    pixels = nullptr;
+}
+
+void SpriteBatch::draw(SpriteId sprite, const SDL_Rect& dest, Uint8 alpha, bool flipX) {
+    const SDL_FRect& coords = uv[sprite];
+    float u0 = coords.x;
+    float u1 = coords.x + coords.w;
+    if (flipX) {
+        float swap = u0;
+        u0 = u1;
+        u1 = swap;
+    }
+    float v0 = coords.y;
+    float v1 = coords.y + coords.h;
+
+    // Premultiplied texels need colour scaled along with alpha to fade correctly.
+    Uint8 tint = premultiplied ? alpha : 255;
+    pushQuad(dest, u0, v0, u1, v1, { tint, tint, tint, alpha });
+}
+
+void SpriteBatch::drawRegion(SpriteId sprite, const SDL_Rect& source, const SDL_Rect& dest) {
+    const SDL_Rect& cell = cells[sprite];
+    float u0 = (cell.x + source.x) * texelWidth;
+    float v0 = (cell.y + source.y) * texelHeight;
+    float u1 = (cell.x + source.x + source.w) * texelWidth;
+    float v1 = (cell.y + source.y + source.h) * texelHeight;
+    pushQuad(dest, u0, v0, u1, v1, { 255, 255, 255, 255 });
+}
+
+void SpriteBatch::pushQuad(const SDL_Rect& dest, float u0, float v0, float u1, float v1, SDL_Color color) {
+    float left = static_cast<float>(dest.x);
+    float top = static_cast<float>(dest.y);
+    float right = left + dest.w;
+    float bottom = top + dest.h;
+
+    int base = static_cast<int>(vertices.size());
+    vertices.push_back({ { left, top }, color, { u0, v0 } });
+    vertices.push_back({ { right, top }, color, { u1, v0 } });
+    vertices.push_back({ { right, bottom }, color, { u1, v1 } });
+    vertices.push_back({ { left, bottom }, color, { u0, v1 } });
+    const int quad[] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+    indices.insert(indices.end(), quad, quad + 6);
+}
+
+void SpriteBatch::flush() {
+    if (!indices.empty() && pixels && rasterizer->active()) {
+        rasterizer->drawQuads(pixels, premultiplied, vertices.data(), indices.data(), static_cast<int>(indices.size()));
+    } else if (!indices.empty() && atlas) {
+        SDL_RenderGeometry(renderer, atlas, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+class SoftwareRasterizer;
+
+enum SpriteId {
+    SPRITE_BACKGROUND,
+    SPRITE_WALL,
+    SPRITE_NINJA,
+    SPRITE_SHURIKEN,
+    SPRITE_ENEMY,
+    SPRITE_PLATFORM,
+    SPRITE_HEART,
+    SPRITE_COUNT
+};
+
+// Packs the background, walls and gameplay sprites, already sized to how
+// they are drawn, into one texture and draws them as quads. Per-sprite alpha
+// travels as vertex colour so nothing touches texture state between sprites;
+// flush() submits every quad queued since the last flush in a single
+// SDL_RenderGeometry call.
+class SpriteBatch {
+public:
+    bool build(SDL_Renderer* renderer, SDL_Surface* const sources[SPRITE_COUNT], bool premultipliedAlpha);
+    void destroy();
+
+    void draw(SpriteId sprite, const SDL_Rect& dest, Uint8 alpha = 255, bool flipX = false);
+    // Draws part of a sprite; source is in the sprite's own pixels.
+    void drawRegion(SpriteId sprite, const SDL_Rect& source, const SDL_Rect& dest);
+    void flush();
+    SDL_Texture* texture() const { return atlas; }
+    // Set before building to keep a CPU copy of the atlas; while the
+    // rasterizer is recording, flush() hands it the quads instead.
+    void setRasterizer(SoftwareRasterizer* target) { rasterizer = target; }
+
+private:
+    void pushQuad(const SDL_Rect& dest, float u0, float v0, float u1, float v1, SDL_Color color);
+
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* atlas = nullptr;
+    SoftwareRasterizer* rasterizer = nullptr;
+    SDL_Surface* pixels = nullptr;
+    bool premultiplied = false;
+    SDL_FRect uv[SPRITE_COUNT] = {};
+    SDL_Rect cells[SPRITE_COUNT] = {};
+    float texelWidth = 0.0f;
+    float texelHeight = 0.0f;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
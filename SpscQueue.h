@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL.h>
+
+// Fixed-size single-producer single-consumer ring. One thread pushes, one
+// thread pops, neither ever blocks or allocates; push fails when the ring is
+// full. Capacity must be a power of two.
+template <typename T, int Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    SpscQueue() {
+        SDL_AtomicSet(&head, 0);
+        SDL_AtomicSet(&tail, 0);
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool push(const T& item) {
+        int write = SDL_AtomicGet(&tail);
+        if (((write - SDL_AtomicGet(&head)) & INDEX_MASK) == Capacity) return false;
+        items[write & (Capacity - 1)] = item;
+        SDL_AtomicSet(&tail, (write + 1) & INDEX_MASK);
+        return true;
+    }
+
+    bool pop(T& item) {
+        int read = SDL_AtomicGet(&head);
+        if (read == SDL_AtomicGet(&tail)) return false;
+        item = items[read & (Capacity - 1)];
+        SDL_AtomicSet(&head, (read + 1) & INDEX_MASK);
+        return true;
+    }
+
+private:
+    // Indices run over twice the capacity so a full ring differs from an empty one.
+    static const int INDEX_MASK = 2 * Capacity - 1;
+
+    T items[Capacity];
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+};
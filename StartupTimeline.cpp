@@ -0,0 +1,42 @@
+#include "StartupTimeline.h"
+#include <algorithm>
+#include <iomanip>
+
+void StartupTimeline::start() {
+    origin = SDL_GetPerformanceCounter();
+    lastMark = origin;
+    firstFrame = 0;
+    spans.clear();
+}
+
+void StartupTimeline::mark(const std::string& label) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    spans.push_back({ label, lastMark, now, 0 });
+    lastMark = now;
+}
+
+void StartupTimeline::addSpan(const std::string& label, Uint64 begin, Uint64 end, int lane) {
+    spans.push_back({ label, begin, end, lane });
+}
+
+void StartupTimeline::markFirstFrame() {
+    mark("first present");
+    firstFrame = lastMark;
+}
+
+void StartupTimeline::print(std::ostream& out) const {
+    std::vector<Span> ordered(spans);
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Span& a, const Span& b) { return a.begin < b.begin; });
+
+    const double msPerCount = 1000.0 / SDL_GetPerformanceFrequency();
+    out << "Startup timeline (ms):" << std::endl;
+    out << std::fixed << std::setprecision(2);
+    for (const auto& span : ordered) {
+        out << "  " << std::setw(8) << (span.begin - origin) * msPerCount
+            << " +" << std::setw(7) << (span.end - span.begin) * msPerCount
+            << "  [" << (span.lane == 0 ? std::string("main") : "worker " + std::to_string(span.lane)) << "] "
+            << span.label << std::endl;
+    }
+    out << "  time to first frame: " << (firstFrame - origin) * msPerCount << std::endl;
+    out << std::defaultfloat;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <SDL.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Records where startup time goes as spans on the performance counter.
+// Lane 0 is the main thread; asset workers report on lanes 1 and up.
+class StartupTimeline {
+public:
+    void start();
+    // Closes a main-thread span running from the previous mark to now.
+    void mark(const std::string& label);
+    void addSpan(const std::string& label, Uint64 begin, Uint64 end, int lane);
+    void markFirstFrame();
+    bool firstFrameShown() const { return firstFrame != 0; }
+    void print(std::ostream& out) const;
+
+private:
+    struct Span {
+        std::string label;
+        Uint64 begin;
+        Uint64 end;
+        int lane;
+    };
+
+    Uint64 origin = 0;
+    Uint64 lastMark = 0;
+    Uint64 firstFrame = 0;
+    std::vector<Span> spans;
+};
@@ -0,0 +1,137 @@
+#include "TextRenderer.h"
+#include "ImageOps.h"
+#include "SoftwareRasterizer.h"
+#include <iostream>
+
+bool TextRenderer::init(SDL_Renderer* targetRenderer, TTF_Font* sourceFont) {
+    renderer = targetRenderer;
+    font = sourceFont;
+    height = TTF_FontHeight(font);
+
+    SDL_Surface* rendered[LAST_GLYPH - FIRST_GLYPH + 1] = {};
+    const SDL_Color white = { 255, 255, 255, 255 };
+
+    // Shelf-pack glyphs left to right, wrapping at ATLAS_WIDTH.
+    int penX = 0;
+    int penY = 0;
+    for (int c = FIRST_GLYPH; c <= LAST_GLYPH; c++) {
+        Glyph& glyph = glyphs[c - FIRST_GLYPH];
+        int minX, maxX, minY, maxY;
+        if (TTF_GlyphMetrics(font, static_cast<Uint16>(c), &minX, &maxX, &minY, &maxY, &glyph.advance) != 0) {
+            glyph.advance = 0;
+        }
+
+        SDL_Surface* surface = TTF_RenderGlyph_Solid(font, static_cast<Uint16>(c), white);
+        rendered[c - FIRST_GLYPH] = surface;
+        if (!surface) continue;
+
+        if (penX + surface->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += height;
+        }
+        glyph.source = { penX, penY, surface->w, surface->h };
+        penX += surface->w + 1;
+    }
+    atlasWidth = ATLAS_WIDTH;
+    atlasHeight = penY + height;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (sheet) {
+        SDL_FillRect(sheet, nullptr, 0);
+        for (int i = 0; i <= LAST_GLYPH - FIRST_GLYPH; i++) {
+            if (rendered[i]) {
+                SDL_BlitSurface(rendered[i], nullptr, sheet, &glyphs[i].source);
+            }
+        }
+        atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+        if (rasterizer) {
+            pixels = premultipliedCopy(sheet, false);
+        }
+        SDL_FreeSurface(sheet);
+    }
+    for (SDL_Surface* surface : rendered) {
+        SDL_FreeSurface(surface);
+    }
+
+    if (!atlas) {
+        std::cerr << "Failed to build glyph atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+    vertices.reserve(256 * 4);
+    indices.reserve(256 * 6);
+    return true;
+}
+
+void TextRenderer::destroy() {
+    SDL_DestroyTexture(atlas);
+    SDL_FreeSurface(pixels);
+    atlas = nullptr;
+    pixels = nullptr;
+}
+
+int TextRenderer::kerning(char previous, char current) const {
+    if (!previous) return 0;
+    return TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(previous), static_cast<Uint16>(current));
+}
+
+int TextRenderer::measure(const char* text) const {
+    int width = 0;
+    char previous = 0;
+    for (const char* p = text; *p; p++) {
+        if (*p < FIRST_GLYPH || *p > LAST_GLYPH) continue;
+        width += kerning(previous, *p) + glyphs[*p - FIRST_GLYPH].advance;
+        previous = *p;
+    }
+    return width;
+}
+
+void TextRenderer::draw(const char* text, SDL_Color color, int x, int y) {
+    if (!atlas) return;
+
+    const float invWidth = 1.0f / atlasWidth;
+    const float invHeight = 1.0f / atlasHeight;
+    int penX = x;
+    char previous = 0;
+
+    for (const char* p = text; *p; p++) {
+        if (*p < FIRST_GLYPH || *p > LAST_GLYPH) continue;
+        const Glyph& glyph = glyphs[*p - FIRST_GLYPH];
+        penX += kerning(previous, *p);
+        previous = *p;
+
+        const SDL_Rect& src = glyph.source;
+        if (src.w > 0 && *p != ' ') {
+            float left = static_cast<float>(penX);
+            float top = static_cast<float>(y);
+            float right = left + src.w;
+            float bottom = top + src.h;
+            float u0 = src.x * invWidth;
+            float v0 = src.y * invHeight;
+            float u1 = (src.x + src.w) * invWidth;
+            float v1 = (src.y + src.h) * invHeight;
+
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back({ { left, top }, color, { u0, v0 } });
+            vertices.push_back({ { right, top }, color, { u1, v0 } });
+            vertices.push_back({ { right, bottom }, color, { u1, v1 } });
+            vertices.push_back({ { left, bottom }, color, { u0, v1 } });
+            const int quad[] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+
+        penX += glyph.advance;
+    }
+}
+
+void TextRenderer::flush() {
+    if (!indices.empty() && pixels && rasterizer->active()) {
+        rasterizer->drawQuads(pixels, false, vertices.data(), indices.data(), static_cast<int>(indices.size()));
+    } else if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, atlas, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <vector>
+
+class SoftwareRasterizer;
+
+// Bakes the printable ASCII glyphs of a font into one texture at startup and
+// draws text as quads from it. draw() only appends vertices; flush() submits
+// everything queued this frame in a single SDL_RenderGeometry call.
+class TextRenderer {
+public:
+    bool init(SDL_Renderer* renderer, TTF_Font* font);
+    void destroy();
+
+    int measure(const char* text) const;
+    int lineHeight() const { return height; }
+    void draw(const char* text, SDL_Color color, int x, int y);
+    void flush();
+    SDL_Texture* texture() const { return atlas; }
+    // Set before building to keep a CPU copy of the atlas; while the
+    // rasterizer is recording, flush() hands it the quads instead.
+    void setRasterizer(SoftwareRasterizer* target) { rasterizer = target; }
+
+private:
+    static const int FIRST_GLYPH = 32;
+    static const int LAST_GLYPH = 126;
+    static const int ATLAS_WIDTH = 512;
+
+    struct Glyph {
+        SDL_Rect source;
+        int advance;
+    };
+
+    int kerning(char previous, char current) const;
+
+    SDL_Renderer* renderer = nullptr;
+    TTF_Font* font = nullptr;
+    SDL_Texture* atlas = nullptr;
+    SoftwareRasterizer* rasterizer = nullptr;
+    SDL_Surface* pixels = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    int height = 0;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1] = {};
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
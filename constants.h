@@ -18,14 +18,34 @@ const float SPEED_INCREASE_RATE = 0.001f;
 const int PLAYER_INVINCIBLE_TIME = 2000;
 const int MULTIPLIER_INCREASE_INTERVAL = 10000;
 const int SCORE_UPDATE_INTERVAL = 1000;
+const int SIM_TICK_RATE = 60;
+const double MAX_FRAME_TIME_MS = 250.0;
+const int IDLE_WAIT_MS = 250;
 const int PLATFORM_SPAWN_RANGE_MIN = 80;
 const int PLATFORM_SPAWN_RANGE_MAX = 130;
 const int PLATFORM_SPAWN_GAP_MIN = 40;
 const int PLATFORM_SPAWN_GAP_MAX = 80;
 const std::string HIGH_SCORE_FILE = "highscore.dat";
+const std::string REPLAY_FILE = "lastrun.njr";
+const std::string COOKED_DIR = "cooked";
+const std::string PACK_FILE = "assets.njp";
+const std::string FONT_FILE = "PixelifySans.ttf";
+const size_t RESOURCE_BUDGET_BYTES = 6 * 1024 * 1024;
+const int REPLAY_CHECKPOINT_INTERVAL = 60;
 const int SHURIKEN_SPEED = 10;
 const int SHURIKEN_WIDTH = PLAYER_WIDTH / 2;
 const int SHURIKEN_HEIGHT = PLAYER_HEIGHT / 2;
 constexpr int ENEMY_WIDTH = 30;
 constexpr int ENEMY_HEIGHT = 30;
 constexpr int ENEMY_HEALTH = 1;
+const int MAX_PLATFORMS = 32;
+const int MAX_ENEMIES = 32;
+const int AUDIO_VOICES = 8;
+const int AUDIO_FREQUENCY = 44100;
+const int AUDIO_BUFFER_FRAMES = 512;
+const int AUDIO_MAX_BUFFER_FRAMES = 4096;
+const int AUDIO_UNDERRUN_LIMIT = 3;
+const int AUDIO_UNDERRUN_WINDOW_MS = 10000;
+const int MUSIC_BUFFER_FRAMES = 2048;
+const int MUSIC_FADE_MS = 800;
+const float MUSIC_VOLUME = 0.5f;
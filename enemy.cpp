@@ -1,27 +1,40 @@
 #include "enemy.h"
 
-Enemy::Enemy(int x, int y, bool isLeftSide) :
-    leftSide(isLeftSide), active(true), health(1) {
-    rect = { x, y, ENEMY_WIDTH, ENEMY_HEIGHT };
+void Enemy::spawn(EntityStore& enemies, int x, int y, bool isLeftSide) {
+    enemies.spawn(x, y, isLeftSide ? LANE_LEFT : LANE_RIGHT, ENEMY_HEALTH);
 }
 
-void Enemy::update(float speed) {
-    rect.y += static_cast<int>(speed);
+void Enemy::update(EntityStore& enemies, float speed) {
+    const int step = static_cast<int>(speed);
+    const size_t count = enemies.slotCount();
+    int* y = enemies.y.data();
+    int* prevY = enemies.prevY.data();
+    Uint8* active = enemies.active.data();
+
+    for (size_t i = 0; i < count; i++) {
+        prevY[i] = y[i];
+        y[i] += step;
+        active[i] = active[i] & (y[i] <= SCREEN_HEIGHT);
+    }
 }
 
-void Enemy::render(SDL_Renderer* renderer, SDL_Texture* texture) {
-    if (active) {
-        SDL_RenderCopy(renderer, texture, nullptr, &rect);
+void Enemy::render(const EntityStore& enemies, SpriteBatch& batch, float interpolation) {
+    for (size_t i = 0; i < enemies.slotCount(); i++) {
+        if (enemies.active[i]) {
+            SDL_Rect destRect = enemies.rect(i);
+            destRect.y = enemies.prevY[i] + static_cast<int>((enemies.y[i] - enemies.prevY[i]) * interpolation);
+            batch.draw(SPRITE_ENEMY, destRect);
+        }
     }
 }
 
-void Enemy::takeDamage() {
-    health--;
-    if (health <= 0) {
-        active = false;
+void Enemy::takeDamage(EntityStore& enemies, size_t i) {
+    enemies.health[i]--;
+    if (enemies.health[i] <= 0) {
+        enemies.active[i] = 0;
     }
 }
 
-SDL_Rect Enemy::getRect() const { return rect; }
-bool Enemy::isActive() const { return active; }
-bool Enemy::isDead() const { return !active && health <= 0; }
+bool Enemy::isDead(const EntityStore& enemies, size_t i) {
+    return !enemies.active[i] && enemies.health[i] <= 0;
+}
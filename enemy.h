@@ -1,23 +1,14 @@
 #pragma once
 #include <SDL.h>
 #include "constants.h"
+#include "EntityStore.h"
+#include "SpriteBatch.h"
 
 class Enemy {
 public:
-    Enemy(int x, int y, bool isLeftSide);
-    void update(float speed);
-    void render(SDL_Renderer* renderer, SDL_Texture* texture);
-    SDL_Rect getRect() const;
-    bool isActive() const;
-    void takeDamage();
-    bool isDead() const;
-
-private:
-    SDL_Rect rect;
-    bool active;
-    bool leftSide;
-    int health;
-    static const int ENEMY_WIDTH = 30;
-    static const int ENEMY_HEIGHT = 30;
+    static void spawn(EntityStore& enemies, int x, int y, bool isLeftSide);
+    static void update(EntityStore& enemies, float speed);
+    static void render(const EntityStore& enemies, SpriteBatch& batch, float interpolation);
+    static void takeDamage(EntityStore& enemies, size_t i);
+    static bool isDead(const EntityStore& enemies, size_t i);
 };
-
@@ -1,10 +1,93 @@
 #include "Game.h"
+#include "Benchmarks.h"
+#include "Assets.h"
+#include <cstdlib>
+#include <cstring>
+
+int runReplays(int count, char* paths[]) {
+    Game game;
+    if (!game.initHeadless()) return 1;
+
+    int failures = 0;
+    Uint64 totalTicks = 0;
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 startCounter = SDL_GetPerformanceCounter();
+
+    for (int i = 0; i < count; i++) {
+        Replay replay;
+        if (!replay.load(paths[i])) {
+            std::cerr << "Failed to load replay: " << paths[i] << std::endl;
+            failures++;
+            continue;
+        }
+        if (!game.playReplay(replay)) {
+            std::cerr << "Replay mismatch: " << paths[i] << std::endl;
+            failures++;
+        }
+        totalTicks += replay.tickCount;
+    }
+
+    double seconds = static_cast<double>(SDL_GetPerformanceCounter() - startCounter) / frequency;
+    std::cout << "Replayed " << count << " runs (" << totalTicks << " ticks) in " << seconds << " s, "
+              << failures << " failed" << std::endl;
+    if (seconds > 0.0 && totalTicks > 0) {
+        std::cout << "ticks/sec: " << totalTicks / seconds << std::endl;
+    }
+    if (const char* audioLog = SDL_getenv("NINJUMP_AUDIO_LOG")) {
+        game.writeAudioLog(audioLog);
+    }
+    return failures == 0 ? 0 : 1;
+}
 
 int main(int argc, char* args[]) {
+    if (argc > 1 && std::strcmp(args[1], "--bench-collision") == 0) {
+        return runCollisionBenchmark();
+    }
+
+    if (argc > 1 && std::strcmp(args[1], "--bench-render") == 0) {
+        return runRenderBenchmark(argc > 2 ? args[2] : REPLAY_FILE.c_str());
+    }
+
+    if (argc > 1 && std::strcmp(args[1], "--bench-audio") == 0) {
+        return runAudioLatencyBenchmark();
+    }
+
+    if (argc > 1 && std::strcmp(args[1], "--cook") == 0) {
+        return cookAssets();
+    }
+
+    if (argc > 1 && std::strcmp(args[1], "--pack") == 0) {
+        return packAssets();
+    }
+
+    if (argc > 2 && std::strcmp(args[1], "--replay") == 0) {
+        return runReplays(argc - 2, args + 2);
+    }
+
     Game game;
+
+    if (argc > 1 && std::strcmp(args[1], "--headless") == 0) {
+        Uint64 ticks = argc > 2 ? std::strtoull(args[2], nullptr, 10) : 1000000;
+        Uint64 seed = argc > 3 ? std::strtoull(args[3], nullptr, 10) : 1;
+        if (game.initHeadless()) {
+            game.setSeed(seed);
+            if (argc > 4) {
+                game.setReplayPath(args[4]);
+            }
+            game.runHeadless(ticks);
+            if (const char* audioLog = SDL_getenv("NINJUMP_AUDIO_LOG")) {
+                game.writeAudioLog(audioLog);
+            }
+        }
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(args[1], "--cpu-render") == 0) {
+        game.setRenderBackend(RenderBackend::CPU_RASTER);
+    }
+
     if (game.init()) {
         game.run();
     }
     return 0;
 }
-
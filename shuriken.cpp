@@ -1,22 +1,28 @@
 #include "shuriken.h"
 
-Shuriken::Shuriken(int x, int y) : active(true) {
-    rect = { x - SHURIKEN_WIDTH/2, y - SHURIKEN_HEIGHT, SHURIKEN_WIDTH, SHURIKEN_HEIGHT };
+void Shuriken::spawn(EntityStore& shurikens, int x, int y) {
+    shurikens.spawn(x - SHURIKEN_WIDTH/2, y - SHURIKEN_HEIGHT, x < SCREEN_WIDTH / 2 ? LANE_LEFT : LANE_RIGHT);
 }
 
-void Shuriken::update() {
-    rect.y -= SHURIKEN_SPEED;
+void Shuriken::update(EntityStore& shurikens) {
+    const size_t count = shurikens.slotCount();
+    int* y = shurikens.y.data();
+    int* prevY = shurikens.prevY.data();
+    Uint8* active = shurikens.active.data();
 
-    if (rect.y < -SHURIKEN_HEIGHT) {
-        active = false;
+    for (size_t i = 0; i < count; i++) {
+        prevY[i] = y[i];
+        y[i] -= SHURIKEN_SPEED;
+        active[i] = active[i] & (y[i] >= -SHURIKEN_HEIGHT);
     }
 }
 
-void Shuriken::render(SDL_Renderer* renderer, SDL_Texture* texture) {
-    if (active) {
-        SDL_RenderCopy(renderer, texture, nullptr, &rect);
+void Shuriken::render(const EntityStore& shurikens, SpriteBatch& batch, float interpolation) {
+    for (size_t i = 0; i < shurikens.slotCount(); i++) {
+        if (shurikens.active[i]) {
+            SDL_Rect destRect = shurikens.rect(i);
+            destRect.y = shurikens.prevY[i] + static_cast<int>((shurikens.y[i] - shurikens.prevY[i]) * interpolation);
+            batch.draw(SPRITE_SHURIKEN, destRect);
+        }
     }
 }
-
-SDL_Rect Shuriken::getRect() const { return rect; }
-bool Shuriken::isActive() const { return active; }